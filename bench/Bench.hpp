@@ -0,0 +1,30 @@
+#pragma once
+// Tiny timing helpers shared by the micro-benchmarks in this folder.
+// Each benchmark is a standalone program, e.g.:
+//   g++ -O2 -std=c++17 -I. bench/bench_emergency_queue.cpp -o bench_emergency_queue
+
+#include <chrono>
+#include <cstdio>
+
+inline double benchSeconds() {
+    using clock = std::chrono::steady_clock;
+    static const clock::time_point start = clock::now();
+    return std::chrono::duration<double>(clock::now() - start).count();
+}
+
+// Prints "<label>: <total ms> ms, <ns per op> ns/op".
+inline void benchReport(const char* label, double seconds, long long ops) {
+    std::printf("%-40s %9.2f ms %9.1f ns/op\n",
+        label, seconds * 1e3, ops > 0 ? seconds * 1e9 / static_cast<double>(ops) : 0.0);
+}
+
+// Deterministic xorshift so runs are comparable.
+struct BenchRng {
+    unsigned state = 2463534242u;
+    unsigned next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+};
@@ -0,0 +1,76 @@
+// Intake throughput with 1..N producer threads and one consumer:
+// sharded ConcurrentPriorityQueue vs. a single mutex around PriorityQueue.
+//   g++ -O2 -std=c++17 -pthread -I. bench/bench_concurrent_intake.cpp -o bench_concurrent_intake
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "bench/Bench.hpp"
+#include "ds/ConcurrentPriorityQueue.hpp"
+#include "ds/DynamicArray.hpp"
+#include "modules/EmergencyPQModule.hpp"
+
+// Baseline: what guarding the module's heap with one lock would give.
+class LockedQueue {
+public:
+    void push(const EmergencyCase& e) {
+        std::lock_guard<std::mutex> guard(lock_);
+        heap_.push(e);
+    }
+    bool tryPopMax(EmergencyCase& out) {
+        std::lock_guard<std::mutex> guard(lock_);
+        return heap_.popMax(out);
+    }
+
+private:
+    std::mutex                                   lock_;
+    PriorityQueue<EmergencyCase, EmergencyHigher> heap_;
+};
+
+template <typename Queue>
+static double run(int producers, int perProducer) {
+    Queue q;
+    std::atomic<int> consumed(0);
+    const int total = producers * perProducer;
+
+    double t0 = benchSeconds();
+    DynamicArray<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace([&q, p, perProducer] {
+            BenchRng rng;
+            rng.state += static_cast<unsigned>(p) * 7919u;
+            EmergencyCase e;
+            e.name = "Desk " + std::to_string(p);
+            e.type = "Walk-in";
+            for (int i = 0; i < perProducer; ++i) {
+                e.priority = 1 + static_cast<int>(rng.next() % 5);
+                q.push(e);
+            }
+            });
+    }
+    threads.emplace([&q, &consumed, total] {
+        EmergencyCase out;
+        while (consumed.load(std::memory_order_relaxed) < total) {
+            if (q.tryPopMax(out)) consumed.fetch_add(1, std::memory_order_relaxed);
+        }
+        });
+    for (int i = 0; i < threads.size(); ++i) threads[i].join();
+    return benchSeconds() - t0;
+}
+
+int main() {
+    const int perProducer = 200000;
+    int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+    if (maxThreads < 2) maxThreads = 2;
+
+    for (int producers = 1; producers <= maxThreads; producers *= 2) {
+        const long long ops = 2LL * producers * perProducer; // push + pop
+        std::printf("producers = %d\n", producers);
+        benchReport("  mutex + PriorityQueue",
+            run<LockedQueue>(producers, perProducer), ops);
+        benchReport("  ConcurrentPriorityQueue",
+            run<ConcurrentPriorityQueue<EmergencyCase, EmergencyHigher>>(producers, perProducer), ops);
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+// Nearest-available dispatch on a large fleet with a steady stream of GPS
+// updates: DispatchEngine (uniform grid) vs. a linear scan over all units.
+//   g++ -O2 -std=c++17 -I. bench/bench_dispatch.cpp modules/DispatchEngine.cpp -o bench_dispatch
+
+#include <string>
+#include "bench/Bench.hpp"
+#include "ds/DynamicArray.hpp"
+#include "modules/DispatchEngine.hpp"
+
+const double AREA = 100.0; // km
+
+static volatile long long sink; // keeps the baseline's result alive
+
+static double coord(BenchRng& rng) {
+    return (rng.next() % 100000) * (AREA / 100000.0);
+}
+
+// Small move around the current position, as between two GPS fixes.
+static double jitter(BenchRng& rng, double v) {
+    v += ((rng.next() % 2001) - 1000.0) * 0.0002; // +-200 m
+    return v < 0 ? 0 : (v > AREA ? AREA : v);
+}
+
+// Baseline: what finding the closest unit by walking the fleet costs.
+struct LinearFleet {
+    DynamicArray<Ambulance> units;
+
+    int nearestAvailable(double x, double y) const {
+        int best = -1;
+        double bestD = 0;
+        for (int i = 0; i < units.size(); ++i) {
+            if (units[i].status != AmbulanceStatus::Available) continue;
+            const double dx = units[i].x - x, dy = units[i].y - y;
+            const double d = dx * dx + dy * dy;
+            if (best < 0 || d < bestD) { best = i; bestD = d; }
+        }
+        return best;
+    }
+};
+
+// updatesPerQuery GPS fixes between two dispatch decisions; a dispatched
+// unit is released again right away so availability stays constant.
+static void run(int units, int queries, int updatesPerQuery) {
+    std::printf("fleet = %d, %d updates per query\n", units, updatesPerQuery);
+    const long long ops = static_cast<long long>(queries) * (updatesPerQuery + 1);
+
+    {
+        BenchRng rng;
+        LinearFleet fleet;
+        for (int i = 0; i < units; ++i) {
+            Ambulance& a = fleet.units.emplace();
+            a.code = "AMB" + std::to_string(i);
+            a.x = coord(rng);
+            a.y = coord(rng);
+            if (i % 4 == 0) a.status = AmbulanceStatus::AtScene;
+        }
+        long long check = 0;
+        double t0 = benchSeconds();
+        for (int q = 0; q < queries; ++q) {
+            for (int u = 0; u < updatesPerQuery; ++u) {
+                Ambulance& a = fleet.units[static_cast<int>(rng.next() % units)];
+                a.x = jitter(rng, a.x);
+                a.y = jitter(rng, a.y);
+            }
+            check += fleet.nearestAvailable(coord(rng), coord(rng));
+        }
+        benchReport("  linear scan", benchSeconds() - t0, ops);
+        sink = check;
+    }
+    {
+        BenchRng rng;
+        DispatchEngine engine(AREA, AREA, 1.0);
+        DynamicArray<double> xs, ys;
+        for (int i = 0; i < units; ++i) {
+            Ambulance a;
+            a.code = "AMB" + std::to_string(i);
+            a.x = coord(rng);
+            a.y = coord(rng);
+            if (i % 4 == 0) a.status = AmbulanceStatus::AtScene;
+            engine.addUnit(a);
+            xs.push(a.x);
+            ys.push(a.y);
+        }
+        double t0 = benchSeconds();
+        for (int q = 0; q < queries; ++q) {
+            for (int u = 0; u < updatesPerQuery; ++u) {
+                const int id = static_cast<int>(rng.next() % units);
+                xs[id] = jitter(rng, xs[id]);
+                ys[id] = jitter(rng, ys[id]);
+                engine.updatePosition(id, xs[id], ys[id]);
+            }
+            Ambulance out;
+            if (engine.dispatchNearest(coord(rng), coord(rng), out))
+                engine.setStatus(engine.unitId(out.code), AmbulanceStatus::Available);
+        }
+        benchReport("  DispatchEngine (grid)", benchSeconds() - t0, ops);
+    }
+}
+
+int main() {
+    run(10000, 20000, 50);
+    run(50000, 5000, 50);
+    run(100000, 2000, 50);
+    return 0;
+}
@@ -0,0 +1,44 @@
+// Plain heap vs. addressable heap vs. bucket queue on the 1..5 triage scale.
+//   g++ -O2 -std=c++17 -I. bench/bench_emergency_queue.cpp -o bench_emergency_queue
+
+#include <string>
+#include "bench/Bench.hpp"
+#include "ds/PriorityQueue.hpp"
+#include "modules/EmergencyPQModule.hpp"
+
+template <typename Queue>
+static void run(const char* label, const EmergencyCase* cases, int n) {
+    Queue q;
+    EmergencyCase out;
+
+    double t0 = benchSeconds();
+    for (int i = 0; i < n; ++i) q.push(cases[i]);
+    double t1 = benchSeconds();
+    while (q.popMax(out)) {}
+    double t2 = benchSeconds();
+
+    std::string name(label);
+    benchReport((name + " push").c_str(), t1 - t0, n);
+    benchReport((name + " popMax").c_str(), t2 - t1, n);
+}
+
+int main() {
+    const int sizes[] = { 1000, 100000, 1000000 };
+    BenchRng rng;
+
+    for (int n : sizes) {
+        EmergencyCase* cases = new EmergencyCase[n];
+        for (int i = 0; i < n; ++i) {
+            cases[i].name = "Patient " + std::to_string(rng.next() % 100000);
+            cases[i].type = "Accident";
+            cases[i].priority = 1 + static_cast<int>(rng.next() % 5);
+        }
+
+        std::printf("n = %d\n", n);
+        run<PriorityQueue<EmergencyCase, EmergencyHigher>>("  PriorityQueue", cases, n);
+        run<EmergencyHeap>("  IndexedPriorityQueue", cases, n);
+        run<EmergencyBuckets>("  BucketQueue", cases, n);
+        delete[] cases;
+    }
+    return 0;
+}
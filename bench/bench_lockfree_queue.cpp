@@ -0,0 +1,84 @@
+// Concurrent patient admissions: N kiosk threads enqueue while N desk
+// threads dequeue, LockFreeQueue (Michael-Scott, hazard pointers) vs. one
+// mutex around LinkedQueue.
+//   g++ -O2 -std=c++17 -pthread -I. bench/bench_lockfree_queue.cpp -o bench_lockfree_queue
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "bench/Bench.hpp"
+#include "ds/DynamicArray.hpp"
+#include "ds/LinkedQueue.hpp"
+#include "ds/LockFreeQueue.hpp"
+
+// Small fixed record so the queue, not string copies, is what is measured.
+struct Admission {
+    unsigned  id;
+    unsigned  condition;
+    long long at;
+};
+
+// Baseline: the single-threaded queue behind one lock.
+template <typename Alloc>
+class LockedLinkedQueue {
+public:
+    void enqueue(const Admission& a) {
+        std::lock_guard<std::mutex> guard(lock_);
+        q_.enqueue(a);
+    }
+    bool dequeue(Admission& out) {
+        std::lock_guard<std::mutex> guard(lock_);
+        return q_.dequeue(out);
+    }
+
+private:
+    std::mutex                    lock_;
+    LinkedQueue<Admission, Alloc> q_;
+};
+
+template <typename Queue>
+static double run(int pairs, int perProducer) {
+    Queue q;
+    std::atomic<int> consumed(0);
+    const int total = pairs * perProducer;
+
+    double t0 = benchSeconds();
+    DynamicArray<std::thread> threads;
+    for (int p = 0; p < pairs; ++p) {
+        threads.emplace([&q, p, perProducer] {
+            Admission a{ 0, static_cast<unsigned>(p), 0 };
+            for (int i = 0; i < perProducer; ++i) {
+                a.id = static_cast<unsigned>(i);
+                q.enqueue(a);
+            }
+            });
+        threads.emplace([&q, &consumed, total] {
+            Admission out;
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                if (q.dequeue(out)) consumed.fetch_add(1, std::memory_order_relaxed);
+            }
+            });
+    }
+    for (int i = 0; i < threads.size(); ++i) threads[i].join();
+    return benchSeconds() - t0;
+}
+
+int main() {
+    const int perProducer = 200000;
+    int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+    if (maxThreads < 2) maxThreads = 2;
+
+    for (int pairs = 1; 2 * pairs <= maxThreads || pairs == 1; pairs *= 2) {
+        const long long ops = 2LL * pairs * perProducer; // enqueue + dequeue
+        std::printf("%d kiosk + %d desk threads\n", pairs, pairs);
+        benchReport("  mutex + LinkedQueue (heap)",
+            run<LockedLinkedQueue<HeapNodeAllocator>>(pairs, perProducer), ops);
+        benchReport("  mutex + LinkedQueue (pool)",
+            run<LockedLinkedQueue<PoolNodeAllocator>>(pairs, perProducer), ops);
+        benchReport("  LockFreeQueue (heap)",
+            run<LockFreeQueue<Admission>>(pairs, perProducer), ops);
+        benchReport("  LockFreeQueue (pool)",
+            run<LockFreeQueue<Admission, PoolNodeAllocator>>(pairs, perProducer), ops);
+    }
+    return 0;
+}
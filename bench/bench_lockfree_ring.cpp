@@ -0,0 +1,97 @@
+// Event-passing throughput for the dispatch path: a mutex around the fixed
+// CircularQueue vs. the lock-free SpscRing / MpmcRing, with 1..N producers
+// and as many consumers.
+//   g++ -O2 -std=c++17 -pthread -I. bench/bench_lockfree_ring.cpp -o bench_lockfree_ring
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "bench/Bench.hpp"
+#include "ds/CircularQueue.hpp"
+#include "ds/DynamicArray.hpp"
+#include "ds/LockFreeRing.hpp"
+
+// A GPS / radio update as it would arrive from an ingestion thread.
+struct DispatchEvent {
+    int       unit = 0;
+    int       x = 0;
+    int       y = 0;
+    long long stamp = 0;
+};
+
+const int RING_SIZE = 1024;
+
+// Baseline: the existing fixed ring behind one lock.
+class LockedRing {
+public:
+    bool tryEnqueue(const DispatchEvent& e) {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (ring_.isFull()) return false;
+        ring_.enqueue(e);
+        return true;
+    }
+    bool tryDequeue(DispatchEvent& out) {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (ring_.isEmpty()) return false;
+        out = ring_.dequeue();
+        return true;
+    }
+
+private:
+    std::mutex                              lock_;
+    CircularQueue<DispatchEvent, RING_SIZE> ring_;
+};
+
+template <typename Ring>
+static double run(int producers, int consumers, int perProducer) {
+    Ring* ring = new Ring();
+    std::atomic<long long> consumed(0);
+    const long long total = static_cast<long long>(producers) * perProducer;
+
+    double t0 = benchSeconds();
+    DynamicArray<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace([ring, p, perProducer] {
+            DispatchEvent e;
+            e.unit = p;
+            for (int i = 0; i < perProducer; ++i) {
+                e.x = i;
+                e.stamp = i;
+                while (!ring->tryEnqueue(e)) std::this_thread::yield();
+            }
+            });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace([ring, &consumed, total] {
+            DispatchEvent out;
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                if (ring->tryDequeue(out)) consumed.fetch_add(1, std::memory_order_relaxed);
+                else std::this_thread::yield();
+            }
+            });
+    }
+    for (int i = 0; i < threads.size(); ++i) threads[i].join();
+    double elapsed = benchSeconds() - t0;
+    delete ring;
+    return elapsed;
+}
+
+int main() {
+    const int perProducer = 1000000;
+
+    std::printf("1 producer / 1 consumer\n");
+    const long long ops = 2LL * perProducer; // enqueue + dequeue
+    benchReport("  mutex + CircularQueue", run<LockedRing>(1, 1, perProducer), ops);
+    benchReport("  SpscRing", run<SpscRing<DispatchEvent, RING_SIZE>>(1, 1, perProducer), ops);
+    benchReport("  MpmcRing", run<MpmcRing<DispatchEvent, RING_SIZE>>(1, 1, perProducer), ops);
+
+    int maxThreads = static_cast<int>(std::thread::hardware_concurrency()) / 2;
+    if (maxThreads < 2) maxThreads = 2;
+    for (int n = 2; n <= maxThreads; n *= 2) {
+        const long long opsN = 2LL * n * perProducer;
+        std::printf("%d producers / %d consumers\n", n, n);
+        benchReport("  mutex + CircularQueue", run<LockedRing>(n, n, perProducer), opsN);
+        benchReport("  MpmcRing", run<MpmcRing<DispatchEvent, RING_SIZE>>(n, n, perProducer), opsN);
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+// Node allocation under churn for LinkedQueue / LinkedStack:
+// HeapNodeAllocator (new/delete per node) vs. PoolNodeAllocator.
+//   g++ -O2 -std=c++17 -pthread -I. bench/bench_node_pool.cpp -o bench_node_pool
+
+#include <cstdlib>
+#include <new>
+#include "bench/Bench.hpp"
+#include "ds/LinkedQueue.hpp"
+#include "ds/LinkedStack.hpp"
+
+static long long g_allocs = 0;
+
+void* operator new(std::size_t n) {
+    ++g_allocs;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Small fixed-size record so the node allocation is the whole cost.
+struct StockEvent {
+    int  batch;
+    int  quantity;
+    long stamp;
+};
+
+static void report(const char* label, double t0, long long a0, long long ops) {
+    benchReport(label, benchSeconds() - t0, ops);
+    std::printf("%-40s %9.3f allocs/op\n", "", static_cast<double>(g_allocs - a0) / ops);
+}
+
+// Random admit/discharge mix around a queue depth of about `depth`.
+template <typename Alloc>
+static void queueChurn(const char* label, int depth, int ops) {
+    LinkedQueue<StockEvent, Alloc> q;
+    BenchRng rng;
+    StockEvent e{ 1, 10, 0 }, out;
+    for (int i = 0; i < depth; ++i) q.enqueue(e);
+    long long a0 = g_allocs;
+    double t0 = benchSeconds();
+    for (int i = 0; i < ops; ++i) {
+        if (rng.next() & 1) q.enqueue(e);
+        else q.dequeue(out);
+    }
+    report(label, t0, a0, ops);
+}
+
+// Deliveries pushed in bursts, then used up.
+template <typename Alloc>
+static void stackBursts(const char* label, int burst, int rounds) {
+    LinkedStack<StockEvent, Alloc> s;
+    StockEvent e{ 1, 10, 0 }, out;
+    long long a0 = g_allocs;
+    double t0 = benchSeconds();
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < burst; ++i) s.push(e);
+        while (s.pop(out)) {}
+    }
+    report(label, t0, a0, 2LL * burst * rounds);
+}
+
+// Snapshot copies (cloneNodes) of a live stack.
+template <typename Alloc>
+static void stackCopies(const char* label, int size, int copies) {
+    LinkedStack<StockEvent, Alloc> s;
+    for (int i = 0; i < size; ++i) s.push(StockEvent{ i, 1, 0 });
+    long long a0 = g_allocs;
+    double t0 = benchSeconds();
+    for (int c = 0; c < copies; ++c) {
+        LinkedStack<StockEvent, Alloc> snapshot(s);
+    }
+    report(label, t0, a0, static_cast<long long>(size) * copies);
+}
+
+int main() {
+    std::printf("queue churn, depth 10000\n");
+    queueChurn<HeapNodeAllocator>("  LinkedQueue, heap", 10000, 5000000);
+    queueChurn<PoolNodeAllocator>("  LinkedQueue, pool", 10000, 5000000);
+
+    std::printf("stack bursts of 1000\n");
+    stackBursts<HeapNodeAllocator>("  LinkedStack, heap", 1000, 2500);
+    stackBursts<PoolNodeAllocator>("  LinkedStack, pool", 1000, 2500);
+
+    std::printf("stack copies, 1000 items\n");
+    stackCopies<HeapNodeAllocator>("  LinkedStack copy, heap", 1000, 2500);
+    stackCopies<PoolNodeAllocator>("  LinkedStack copy, pool", 1000, 2500);
+    return 0;
+}
@@ -0,0 +1,112 @@
+// Heap bytes held per waiting patient with a million patients admitted:
+// PatientQueueModule (node, id index, lane bookkeeping, strings) against
+// the original LinkedQueue<Patient> layout.
+//   g++ -O2 -std=c++17 -I. bench/bench_patient_memory.cpp modules/PatientQueueModule.cpp -o bench_patient_memory
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include "bench/Bench.hpp"
+#include "ds/LinkedQueue.hpp"
+#include "models/Patient.hpp"
+#include "modules/PatientQueueModule.hpp"
+
+// Live heap bytes: every block carries its size in a 16-byte header.
+static long long g_liveBytes = 0;
+
+void* operator new(std::size_t n) {
+    void* raw = std::malloc(n + 16);
+    if (!raw) throw std::bad_alloc();
+    *static_cast<std::size_t*>(raw) = n;
+    g_liveBytes += static_cast<long long>(n);
+    return static_cast<char*>(raw) + 16;
+}
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    void* raw = static_cast<char*>(p) - 16;
+    g_liveBytes -= static_cast<long long>(*static_cast<std::size_t*>(raw));
+    std::free(raw);
+}
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+
+static const char* const kNames[] = {
+    "Ali Ahmad", "Siti Nur", "Mohamed Omar", "Zara Lee", "Chen Wei",
+    "Prakash Nair", "Amina Farouk", "Hafiz Rahman", "Nur Izzah", "Ryan Lim",
+};
+static const char* const kConditions[] = {
+    "Flu", "Headache", "Broken Arm", "High Fever", "Allergy",
+    "Stomach Pain", "Back Pain", "Dehydration", "Food Poisoning", "Asthma",
+};
+
+static void makePatient(int i, Patient& p) {
+    p.id = "P" + std::to_string(i + 1);
+    p.name = kNames[i % 10];
+    p.conditionType = kConditions[(i / 10) % 10];
+}
+
+static void reportHeld(const char* label, long long held, int n) {
+    std::printf("%-40s %7.1f MB %9.1f bytes/patient\n", label,
+        static_cast<double>(held) / (1024.0 * 1024.0), static_cast<double>(held) / n);
+}
+
+// Baseline: the original layout, whole Patient records (three strings) in a
+// plain LinkedQueue, no index.
+static long long heldByPatientQueue(int n) {
+    const long long before = g_liveBytes;
+    LinkedQueue<Patient> queue;
+    Patient p;
+    for (int i = 0; i < n; ++i) {
+        makePatient(i, p);
+        queue.enqueue(p);
+    }
+    return g_liveBytes - before;
+}
+
+// The same queue holding compact PatientRecords, to separate the record
+// layout from the module's index and lane bookkeeping.
+static long long heldByRecordQueue(int n) {
+    const long long before = g_liveBytes;
+    LinkedQueue<PatientRecord> queue;
+    Patient p;
+    PatientRecord r;
+    for (int i = 0; i < n; ++i) {
+        makePatient(i, p);
+        toRecord(p, r);
+        queue.enqueue(r);
+    }
+    return g_liveBytes - before;
+}
+
+int main() {
+    const int n = 1000000;
+    const long long baseline = heldByPatientQueue(n);
+    const long long records = heldByRecordQueue(n);
+
+    PatientQueueModule queue;
+    queue.addLane("Fever", 2);
+    queue.routeCondition("Flu", "Fever");
+    queue.routeCondition("High Fever", "Fever");
+
+    const long long before = g_liveBytes;
+    double t0 = benchSeconds();
+    Patient p;
+    for (int i = 0; i < n; ++i) {
+        makePatient(i, p);
+        queue.admit(p);
+    }
+    benchReport("admit 1M", benchSeconds() - t0, n);
+    const long long held = g_liveBytes - before;
+
+    t0 = benchSeconds();
+    Patient out;
+    while (queue.discharge(out)) {}
+    benchReport("discharge 1M", benchSeconds() - t0, n);
+
+    std::printf("sizeof(Patient) %d bytes, sizeof(PatientRecord) %d bytes\n",
+        static_cast<int>(sizeof(Patient)), static_cast<int>(sizeof(PatientRecord)));
+    std::printf("heap held at 1M waiting:\n");
+    reportHeld("  LinkedQueue<Patient> (baseline)", baseline, n);
+    reportHeld("  LinkedQueue<PatientRecord>", records, n);
+    reportHeld("  PatientQueueModule (records + index)", held, n);
+    return 0;
+}
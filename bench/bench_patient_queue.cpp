@@ -0,0 +1,88 @@
+// Patient admission queue: LinkedQueue (one heap node per patient) vs.
+// ChunkedQueue (32 patients per block, spare blocks reused), and handing a
+// whole waiting list to another ward: element by element vs. splice.
+//   g++ -O2 -std=c++17 -I. bench/bench_patient_queue.cpp -o bench_patient_queue
+
+#include <string>
+#include "bench/Bench.hpp"
+#include "ds/ChunkedQueue.hpp"
+#include "ds/LinkedQueue.hpp"
+#include "models/Patient.hpp"
+
+static Patient makePatient(int i) {
+    return Patient{ "P" + std::to_string(i), "Patient name long enough to allocate", "Chest Pain" };
+}
+
+// Mass-casualty burst: admit n patients, then discharge them all.
+template <typename Queue>
+static void burst(const char* label, int n, int rounds) {
+    Queue q;
+    Patient p = makePatient(1), out;
+    double t0 = benchSeconds();
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < n; ++i) q.enqueue(p);
+        while (q.dequeue(out)) {}
+    }
+    benchReport(label, benchSeconds() - t0, 2LL * n * rounds);
+}
+
+// Steady ward: depth patients waiting, one admitted per discharge.
+template <typename Queue>
+static void steady(const char* label, int depth, int ops) {
+    Queue q;
+    Patient out;
+    for (int i = 0; i < depth; ++i) q.enqueue(makePatient(i));
+    double t0 = benchSeconds();
+    for (int i = 0; i < ops; ++i) {
+        q.dequeue(out);
+        q.enqueue(out);
+    }
+    benchReport(label, benchSeconds() - t0, 2LL * ops);
+}
+
+// Ward transfer: move n waiting patients onto another ward's queue.
+static void transferEach(const char* label, int n, int rounds) {
+    LinkedQueue<Patient> ward, target;
+    Patient out;
+    double total = 0;
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < n; ++i) ward.enqueue(makePatient(i));
+        double t0 = benchSeconds();
+        while (ward.dequeue(out)) target.enqueue(std::move(out));
+        total += benchSeconds() - t0;
+        target = LinkedQueue<Patient>();
+    }
+    benchReport(label, total, rounds);
+}
+
+static void transferSplice(const char* label, int n, int rounds) {
+    LinkedQueue<Patient> ward, target;
+    double total = 0;
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < n; ++i) ward.enqueue(makePatient(i));
+        double t0 = benchSeconds();
+        target.splice(std::move(ward));
+        total += benchSeconds() - t0;
+        target = LinkedQueue<Patient>();
+    }
+    benchReport(label, total, rounds);
+}
+
+int main() {
+    for (int n : { 1000, 100000 }) {
+        std::printf("burst of %d admissions, then discharge all\n", n);
+        const int rounds = 2000000 / n;
+        burst<LinkedQueue<Patient>>("  LinkedQueue", n, rounds);
+        burst<ChunkedQueue<Patient>>("  ChunkedQueue<32>", n, rounds);
+        burst<ChunkedQueue<Patient, 64>>("  ChunkedQueue<64>", n, rounds);
+    }
+
+    std::printf("steady state, 10000 waiting\n");
+    steady<LinkedQueue<Patient>>("  LinkedQueue", 10000, 2000000);
+    steady<ChunkedQueue<Patient>>("  ChunkedQueue<32>", 10000, 2000000);
+
+    std::printf("ward transfer of 10000 patients (per transfer)\n");
+    transferEach("  dequeue + enqueue(T&&)", 10000, 50);
+    transferSplice("  splice", 10000, 50);
+    return 0;
+}
@@ -0,0 +1,64 @@
+// Allocations and time per operation for PriorityQueue<EmergencyCase>:
+// copy-in vs. move-in/emplace, binary vs. 4-ary layout.
+//   g++ -O2 -std=c++17 -I. bench/bench_priority_queue_moves.cpp -o bench_priority_queue_moves
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include "bench/Bench.hpp"
+#include "ds/PriorityQueue.hpp"
+#include "modules/EmergencyPQModule.hpp"
+
+static long long g_allocs = 0;
+
+void* operator new(std::size_t n) {
+    ++g_allocs;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Names and types longer than the small-string buffer, so every string copy
+// is a real allocation.
+static EmergencyCase makeCase(BenchRng& rng) {
+    EmergencyCase c;
+    c.name = "Patient record #" + std::to_string(rng.next() % 1000000);
+    c.type = "Multiple trauma / road accident";
+    c.priority = 1 + static_cast<int>(rng.next() % 5);
+    return c;
+}
+
+template <int Arity>
+static void run(const char* label, int n, bool moveIn) {
+    PriorityQueue<EmergencyCase, EmergencyHigher, Arity> q;
+    BenchRng rng;
+    EmergencyCase* cases = new EmergencyCase[n];
+    for (int i = 0; i < n; ++i) cases[i] = makeCase(rng);
+
+    long long a0 = g_allocs;
+    double t0 = benchSeconds();
+    for (int i = 0; i < n; ++i) {
+        if (moveIn) q.push(std::move(cases[i]));
+        else q.push(cases[i]);
+    }
+    EmergencyCase out;
+    while (q.popMax(out)) {}
+    double t1 = benchSeconds();
+    long long allocs = g_allocs - a0;
+
+    benchReport(label, t1 - t0, 2LL * n);
+    std::printf("%-40s %9.3f allocs/op\n", "", static_cast<double>(allocs) / (2.0 * n));
+    delete[] cases;
+}
+
+int main() {
+    const int sizes[] = { 100000, 1000000 };
+    for (int n : sizes) {
+        std::printf("n = %d (push + popMax)\n", n);
+        run<2>("  binary, push(const T&)", n, false);
+        run<2>("  binary, push(T&&)", n, true);
+        run<4>("  4-ary,  push(T&&)", n, true);
+    }
+    return 0;
+}
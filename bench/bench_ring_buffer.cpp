@@ -0,0 +1,44 @@
+// Fixed-size CircularQueue (modulo indexing, array of constructed slots) vs.
+// the growable power-of-two ring (mask indexing, raw storage).
+//   g++ -O2 -std=c++17 -I. bench/bench_ring_buffer.cpp -o bench_ring_buffer
+
+#include <string>
+#include "bench/Bench.hpp"
+#include "ds/CircularQueue.hpp"
+#include "models/Ambulance.hpp"
+
+template <typename Queue>
+static void churn(const char* label, Queue& q, int depth, int ops) {
+    Ambulance a{ "AMB-UNIT-0000001", "Driver with a long enough name" };
+
+    for (int i = 0; i < depth; ++i) q.enqueue(a);
+    double t0 = benchSeconds();
+    for (int i = 0; i < ops; ++i) {
+        Ambulance out = q.dequeue();
+        q.enqueue(std::move(out));
+    }
+    benchReport(label, benchSeconds() - t0, ops);
+    while (!q.isEmpty()) q.dequeue();
+}
+
+int main() {
+    const int ops = 5000000;
+
+    static CircularQueue<Ambulance, 1000> fixed1000;
+    CircularQueue<Ambulance, CIRCULAR_GROWABLE> growable;
+
+    std::printf("dequeue + enqueue, 1000 units in rotation\n");
+    churn("  fixed (MAX_SIZE = 1000)", fixed1000, 1000, ops);
+    churn("  growable", growable, 1000, ops);
+
+    std::printf("fill from empty (includes growth)\n");
+    for (int n : { 1000, 100000 }) {
+        Ambulance a{ "AMB-UNIT-0000001", "Driver with a long enough name" };
+        CircularQueue<Ambulance, CIRCULAR_GROWABLE> q;
+        double t0 = benchSeconds();
+        for (int i = 0; i < n; ++i) q.enqueue(a);
+        std::string label = "  growable, n = " + std::to_string(n);
+        benchReport(label.c_str(), benchSeconds() - t0, n);
+    }
+    return 0;
+}
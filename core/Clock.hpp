@@ -0,0 +1,24 @@
+#pragma once
+#include <chrono>
+
+// Time source the modules measure waits, SLAs and aging with: whole seconds
+// on the steady clock, unless a test or simulation installs its own function.
+class Clock {
+public:
+    using Source = long long (*)();
+
+    static long long steadySeconds() {
+        using namespace std::chrono;
+        return duration_cast<seconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    Clock() : now_(&steadySeconds) {}
+
+    long long operator()() const { return now_(); }
+
+    // nullptr goes back to the steady clock.
+    void set(Source now) { now_ = now ? now : &steadySeconds; }
+
+private:
+    Source now_;
+};
@@ -3,6 +3,7 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include "Menu.hpp"
 #include "Utils.hpp"
@@ -15,6 +16,7 @@
 #include "../models/SupplyItem.hpp"
 #include "../models/EmergencyCase.hpp"
 #include "../models/Ambulance.hpp"
+#include "../ds/DynamicArray.hpp"
 
 using std::string;
 
@@ -72,6 +74,11 @@ namespace {
             std::getline(ss, qtyStr, ',');
             std::getline(ss, s.batch, ',');
 
+            string expiry;
+            std::getline(ss, expiry, ',');
+            if (!expiry.empty() && expiry.back() == '\r') expiry.pop_back();
+            if (!expiry.empty() && !parseDate(expiry, s.expiryDay)) continue;
+
             if (!qtyStr.empty()) s.quantity = std::stoi(qtyStr);
             if (!s.type.empty() && s.quantity > 0) {
                 module.add(s);
@@ -84,6 +91,7 @@ namespace {
         std::ifstream in(path);
         if (!in) return;
 
+        DynamicArray<EmergencyCase> batch;
         string line;
         getlineSafe(in, line); 
 
@@ -101,9 +109,10 @@ namespace {
             if (!prioStr.empty()) e.priority = std::stoi(prioStr);
 
             if (!e.name.empty()) {
-                module.logCase(e);
+                batch.push(std::move(e));
             }
         }
+        module.logCases(batch.data(), batch.size());
     }
 
     //  Load Ambulances 
@@ -163,6 +172,21 @@ int Menu::run() {
     EmergencyPQModule         emergencies;
     AmbulanceCircularModule   ambulances;
 
+    // Pending cases move up one priority level per 15 minutes of waiting.
+    AgingPolicy aging;
+    aging.stepSeconds = 15 * 60;
+    emergencies.setAgingPolicy(aging);
+
+    // Triage lanes; anything not routed here waits in General.
+    patients.addLane("Cardiac", 3);
+    patients.addLane("Fever", 2);
+    patients.addLane("Orthopedics", 1);
+    patients.routeCondition("Chest Pain", "Cardiac");
+    patients.routeCondition("Flu", "Fever");
+    patients.routeCondition("High Fever", "Fever");
+    patients.routeCondition("Broken Arm", "Orthopedics");
+    patients.routeCondition("Back Pain", "Orthopedics");
+
     // -------- LOAD SEED DATA --------
     loadAllSeeds(patients, supplies, emergencies, ambulances);
 
@@ -185,11 +209,15 @@ int Menu::run() {
             for (;;) {
                 std::cout << "\n[Patient Admission]\n"
                     "1) Admit patient\n"
-                    "2) Discharge earliest\n"
+                    "2) Discharge next (all lanes)\n"
                     "3) View queue\n"
+                    "4) Find patient by ID\n"
+                    "5) Remove patient (transfer / walk-out)\n"
+                    "6) Discharge next from a lane\n"
+                    "7) Lane statistics\n"
                     "0) Back\n> ";
 
-                int c = readIntInRange("", 0, 3);
+                int c = readIntInRange("", 0, 7);
                 if (c == 0) break;
 
                 if (c == 1) {
@@ -203,13 +231,43 @@ int Menu::run() {
                 else if (c == 2) {
                     Patient out;
                     if (patients.discharge(out))
-                        std::cout << "Discharged: " << out.name << "\n";
+                        std::cout << "Discharged: " << out.name << " (" << out.conditionType << ")\n";
                     else
                         std::cout << "No patients in queue.\n";
 
                 }
                 else if (c == 3) {
                     patients.printQueue(std::cout);
+
+                }
+                else if (c == 4) {
+                    string id = readString("ID: ");
+                    Patient p;
+                    if (patients.findById(id, p))
+                        std::cout << p.id << " | " << p.name << " | " << p.conditionType
+                        << " [" << patients.laneOf(id) << ", "
+                        << patients.positionOf(id) << " ahead]\n";
+                    else
+                        std::cout << "No patient " << id << " in queue.\n";
+
+                }
+                else if (c == 5) {
+                    Patient out;
+                    if (patients.removeById(readString("ID: "), out))
+                        std::cout << "Removed from queue: " << out.name << "\n";
+                    else
+                        std::cout << "No such patient in queue.\n";
+                }
+                else if (c == 6) {
+                    string lane = readString("Lane: ");
+                    Patient out;
+                    if (patients.dischargeFrom(lane, out))
+                        std::cout << "Discharged from " << lane << ": " << out.name << "\n";
+                    else
+                        std::cout << "No patients waiting in lane " << lane << ".\n";
+                }
+                else if (c == 7) {
+                    patients.printLaneStats(std::cout);
                 }
                 pause_and_clear();
             }
@@ -222,9 +280,13 @@ int Menu::run() {
                     "1) Add stock\n"
                     "2) Use last added\n"
                     "3) View supplies\n"
+                    "4) Stock of a type\n"
+                    "5) Stock summary by type\n"
+                    "6) Use first-expiring of a type (FEFO)\n"
+                    "7) Expired or expiring within N days\n"
                     "0) Back\n> ";
 
-                int c = readIntInRange("", 0, 3);
+                int c = readIntInRange("", 0, 7);
                 if (c == 0) break;
 
                 if (c == 1) {
@@ -232,7 +294,11 @@ int Menu::run() {
                     s.type = readString("Type: ");
                     s.quantity = readIntInRange("Quantity: ", 1, 1000000);
                     s.batch = readString("Batch: ");
-                    supplies.add(s);
+                    string expiry = readString("Expiry (YYYY-MM-DD, blank if none): ");
+                    if (!expiry.empty() && !parseDate(expiry, s.expiryDay))
+                        std::cout << "[Error] Invalid expiry date " << expiry << ".\n";
+                    else
+                        supplies.add(s);
 
                 }
                 else if (c == 2) {
@@ -248,6 +314,25 @@ int Menu::run() {
                 else if (c == 3) {
                     supplies.printAll(std::cout);
                 }
+                else if (c == 4) {
+                    string type = readString("Type: ");
+                    const SupplyTotal total = supplies.totalsOf(type);
+                    std::cout << type << ": " << total.quantity << " units in "
+                        << total.batches << " batch(es)\n";
+                }
+                else if (c == 5) {
+                    supplies.printSummary(std::cout);
+                }
+                else if (c == 6) {
+                    SupplyItem out;
+                    if (supplies.useFirstExpiring(readString("Type: "), todayDay(), out))
+                        std::cout << "Used: " << out.type << " x" << out.quantity
+                        << " (" << out.batch << ", expires " << formatDate(out.expiryDay) << ")\n";
+                }
+                else if (c == 7) {
+                    supplies.printExpiring(std::cout, todayDay(),
+                        readIntInRange("Days: ", 0, 3650));
+                }
                 pause_and_clear();
             }
         }
@@ -261,9 +346,13 @@ int Menu::run() {
                     "3) View by priority\n"
                     "4) Peek next critical\n"
                     "5) View statistics\n"
+                    "6) Re-triage case\n"
+                    "7) Cancel case\n"
+                    "8) Next 5 most critical\n"
+                    "9) Cases at or above a priority\n"
                     "0) Back\n> ";
 
-                int c = readIntInRange("", 0, 5);
+                int c = readIntInRange("", 0, 9);
                 if (c == 0) break;
 
                 if (c == 1) {
@@ -271,7 +360,7 @@ int Menu::run() {
                     e.name = readString("Patient name: ");
                     e.type = readString("Emergency type: ");
                     e.priority = readIntInRange("Priority (1..5): ", 1, 5);
-                    emergencies.logCase(e);
+                    emergencies.logCase(std::move(e));
 
                 }
                 else if (c == 2) {
@@ -280,16 +369,44 @@ int Menu::run() {
 
                 }
                 else if (c == 3) {
+                    emergencies.applyAging();
                     emergencies.printByPriority(std::cout);
 
                 }
                 else if (c == 4) {
                     EmergencyCase out;
+                    emergencies.applyAging();
                     emergencies.peekTop(out);
 
                 }
                 else if (c == 5) {
+                    emergencies.applyAging();
                     emergencies.printStats(std::cout);
+
+                }
+                else if (c == 6) {
+                    int ticket = readIntInRange("Ticket #: ", 0, 1000000000);
+                    int priority = readIntInRange("New priority (1..5): ", 1, 5);
+                    emergencies.retriage(ticket, priority);
+
+                }
+                else if (c == 7) {
+                    EmergencyCase out;
+                    emergencies.cancel(readIntInRange("Ticket #: ", 0, 1000000000), out);
+
+                }
+                else if (c == 8 || c == 9) {
+                    DynamicArray<EmergencyCase> found;
+                    emergencies.applyAging();
+                    if (c == 8) emergencies.topK(5, found);
+                    else emergencies.casesAtLeast(readIntInRange("Minimum priority (1..5): ", 1, 5), found);
+
+                    if (found.isEmpty()) std::cout << "No matching cases.\n";
+                    for (int i = 0; i < found.size(); ++i) {
+                        std::cout << (i + 1) << ") " << found[i].name
+                            << " - " << found[i].type
+                            << " (priority " << found[i].priority << ")\n";
+                    }
                 }
                 pause_and_clear();
             }
@@ -303,9 +420,18 @@ int Menu::run() {
                     "2) Rotate shift\n"
                     "3) Display rotation\n"
                     "4) Check ambulance count\n"
+                    "5) Advance rotation by k\n"
+                    "6) Rotate to unit\n"
+                    "7) Find unit by code\n"
+                    "8) Remove unit from rotation\n"
+                    "9) Update unit position\n"
+                    "10) Dispatch nearest available\n"
+                    "11) Set unit status\n"
+                    "12) Dispatch next available in rotation\n"
+                    "13) Fleet status summary\n"
                     "0) Back\n> ";
 
-                int c = readIntInRange("", 0, 4);
+                int c = readIntInRange("", 0, 13);
                 if (c == 0) break;
 
                 if (c == 1) {
@@ -326,6 +452,59 @@ int Menu::run() {
                 else if (c == 4) {
                     std::cout << "Total ambulances: "
                         << ambulances.getAmbulanceCount() << "\n";
+
+                }
+                else if (c == 5) {
+                    ambulances.advanceRotation(readIntInRange("Units to skip: ", 0, 1000000));
+
+                }
+                else if (c == 6) {
+                    ambulances.rotateTo(readString("Code: "));
+
+                }
+                else if (c == 7) {
+                    string code = readString("Code: ");
+                    const Ambulance* a = ambulances.findByCode(code);
+                    if (a)
+                        std::cout << *a << " (position "
+                        << ambulances.positionOf(code) + 1 << " in rotation)\n";
+                    else
+                        std::cout << "No ambulance with code " << code << ".\n";
+
+                }
+                else if (c == 8) {
+                    Ambulance out;
+                    ambulances.removeAmbulance(readString("Code: "), out);
+
+                }
+                else if (c == 9) {
+                    string code = readString("Code: ");
+                    int x = readIntInRange("X (km): ", 0, 100);
+                    int y = readIntInRange("Y (km): ", 0, 100);
+                    if (ambulances.updatePosition(code, x, y))
+                        std::cout << code << " reported at " << x << "," << y << "\n";
+
+                }
+                else if (c == 10) {
+                    int x = readIntInRange("Incident X (km): ", 0, 100);
+                    int y = readIntInRange("Incident Y (km): ", 0, 100);
+                    Ambulance out;
+                    ambulances.dispatchNearest(x, y, out);
+
+                }
+                else if (c == 11) {
+                    string code = readString("Code: ");
+                    int s = readIntInRange("1) Available  2) En route  3) At scene  4) Out of service: ", 1, 4);
+                    ambulances.setStatus(code, static_cast<AmbulanceStatus>(s - 1));
+
+                }
+                else if (c == 12) {
+                    Ambulance out;
+                    ambulances.dispatchNextInRotation(out);
+
+                }
+                else if (c == 13) {
+                    ambulances.printStatusSummary(std::cout);
                 }
                 pause_and_clear();
             }
@@ -17,6 +17,8 @@
 #include "models/EmergencyCase.hpp"
 #include "models/Ambulance.hpp"
 
+#include "ds/DynamicArray.hpp"
+
 // ---------------- input helpers ----------------
 std::string readString(const char* prompt) {
     if (prompt && *prompt) std::cout << prompt;
@@ -95,6 +97,17 @@ static bool split3(const std::string& line, std::string& a, std::string& b, std:
 }
 
 // ---------------- file-specific loaders ----------------
+// "P###,name,condition" straight into the compact record: the ID is parsed
+// and the condition interned once here, with no intermediate Patient.
+static bool admitPatientRow(const std::string& line, PatientQueueModule& mod) {
+    std::string id, cond;
+    PatientRecord r;
+    if (!split3(line, id, r.name, cond)) return false;
+    if (!parsePatientId(id, r.id)) return false;
+    if (!ConditionTable::intern(cond, r.condition)) return false;
+    return mod.admit(r);
+}
+
 bool loadPatientsCSV(const char* path, PatientQueueModule& mod, int& loaded, int& skipped) {
     loaded = skipped = 0;
     std::ifstream f;
@@ -110,31 +123,35 @@ bool loadPatientsCSV(const char* path, PatientQueueModule& mod, int& loaded, int
         }
         else {
             // Not a header; process this line too
-            std::string id, name, cond;
-            if (split3(line, id, name, cond)) {
-                mod.admit(Patient{ id, name, cond });
-                ++loaded;
-            }
-            else {
-                ++skipped;
-            }
+            if (admitPatientRow(line, mod)) ++loaded;
+            else ++skipped;
         }
     }
     // Process remaining lines
     while (nextDataLine(f, line)) {
-        std::string id, name, cond;
-        if (split3(line, id, name, cond)) {
-            mod.admit(Patient{ id, name, cond });
-            ++loaded;
-        }
-        else {
-            ++skipped;
-        }
+        if (admitPatientRow(line, mod)) ++loaded;
+        else ++skipped;
     }
     std::cout << "[Seed] Patients: loaded=" << loaded << ", skipped=" << skipped << "\n";
     return true;
 }
 
+// "type,qty,batch[,YYYY-MM-DD]"; a missing or blank expiry means none.
+static bool parseSupplyRow(const std::string& line, SupplyItem& out) {
+    std::string qtyStr;
+    if (!split3(line, out.type, qtyStr, out.batch)) return false;
+    std::stringstream ss(qtyStr);
+    if (!(ss >> out.quantity) || out.quantity <= 0) return false;
+
+    std::stringstream rest(line);
+    std::string field;
+    for (int i = 0; i < 4 && std::getline(rest, field, ','); ++i) {}
+    if (rest.fail()) field.clear();   // no fourth field
+    trimInPlace(field);
+    out.expiryDay = SUPPLY_NO_EXPIRY;
+    return field.empty() || parseDate(field, out.expiryDay);
+}
+
 bool loadSuppliesCSV(const char* path, SupplyStackModule& mod, int& loaded, int& skipped) {
     loaded = skipped = 0;
     std::ifstream f;
@@ -146,29 +163,19 @@ bool loadSuppliesCSV(const char* path, SupplyStackModule& mod, int& loaded, int&
         std::string h = trimCopy(line);
         if (!(h.find("Type") != std::string::npos && h.find("Quantity") != std::string::npos)) {
             // Process first line
-            std::string type, qtyStr, batch;
-            if (split3(line, type, qtyStr, batch)) {
-                int qty = 0;
-                std::stringstream ss(qtyStr);
-                if (ss >> qty && qty > 0) {
-                    mod.add(SupplyItem{ type, qty, batch });
-                    ++loaded;
-                }
-                else ++skipped;
+            SupplyItem item;
+            if (parseSupplyRow(line, item)) {
+                mod.add(item);
+                ++loaded;
             }
             else ++skipped;
         }
     }
     while (nextDataLine(f, line)) {
-        std::string type, qtyStr, batch;
-        if (split3(line, type, qtyStr, batch)) {
-            int qty = 0;
-            std::stringstream ss(qtyStr);
-            if (ss >> qty && qty > 0) {
-                mod.add(SupplyItem{ type, qty, batch });
-                ++loaded;
-            }
-            else ++skipped;
+        SupplyItem item;
+        if (parseSupplyRow(line, item)) {
+            mod.add(item);
+            ++loaded;
         }
         else ++skipped;
     }
@@ -188,6 +195,8 @@ bool loadEmergenciesCSV(const char* path, EmergencyPQModule& mod, int& loaded, i
     std::ifstream f;
     if (!openFile(path, f)) return false;
 
+    // Rows are collected first and handed over in one bulk insert.
+    DynamicArray<EmergencyCase> batch;
     std::string line;
     // Skip header if present
     if (nextDataLine(f, line)) {
@@ -198,7 +207,7 @@ bool loadEmergenciesCSV(const char* path, EmergencyPQModule& mod, int& loaded, i
             if (split3(line, name, type, prStr)) {
                 int pr = 0;
                 if (validPriorityInt(prStr, pr)) {
-                    mod.logCase(EmergencyCase{ name, type, pr });
+                    batch.push(EmergencyCase{ name, type, pr });
                     ++loaded;
                 }
                 else ++skipped;
@@ -211,13 +220,14 @@ bool loadEmergenciesCSV(const char* path, EmergencyPQModule& mod, int& loaded, i
         if (split3(line, name, type, prStr)) {
             int pr = 0;
             if (validPriorityInt(prStr, pr)) {
-                mod.logCase(EmergencyCase{ name, type, pr });
+                batch.push(EmergencyCase{ name, type, pr });
                 ++loaded;
             }
             else ++skipped;
         }
         else ++skipped;
     }
+    mod.logCases(batch.data(), batch.size());
     std::cout << "[Seed] Emergencies: loaded=" << loaded << ", skipped=" << skipped << "\n";
     return true;
 }
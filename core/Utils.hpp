@@ -15,9 +15,12 @@ std::string trimCopy(const std::string& s);
 
 class PatientQueueModule;
 class SupplyStackModule;
-class EmergencyPQModule;
 class AmbulanceCircularModule;
 
+// EmergencyPQModule is an alias of a class template, so it can't be
+// forward-declared.
+#include "../modules/EmergencyPQModule.hpp"
+
 bool loadPatientsCSV(const char* path, PatientQueueModule& mod, int& loaded, int& skipped);
 bool loadSuppliesCSV(const char* path, SupplyStackModule& mod, int& loaded, int& skipped);
 bool loadEmergenciesCSV(const char* path, EmergencyPQModule& mod, int& loaded, int& skipped);
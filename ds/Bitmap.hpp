@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Packed fixed-size bit set, 64 bits per word. findNext scans a whole word
+// per step with a count-trailing-zeros instruction, so looking for the next
+// set bit among n costs O(n / 64) in the worst case and O(1) when one is near.
+class Bitmap {
+public:
+    explicit Bitmap(int bits = 0) : words_(nullptr), nwords_(0), bits_(0) {
+        resize(bits);
+    }
+    ~Bitmap() { delete[] words_; }
+
+    Bitmap(const Bitmap&) = delete;
+    Bitmap& operator=(const Bitmap&) = delete;
+
+    // Change the size; every bit is cleared.
+    void resize(int bits) {
+        delete[] words_;
+        bits_ = bits;
+        nwords_ = (bits + 63) / 64;
+        words_ = nwords_ > 0 ? new std::uint64_t[nwords_] : nullptr;
+        clear();
+    }
+
+    void clear() {
+        for (int w = 0; w < nwords_; ++w) words_[w] = 0;
+    }
+
+    void set(int i) { words_[i >> 6] |= bit(i); }
+    void reset(int i) { words_[i >> 6] &= ~bit(i); }
+    void assign(int i, bool on) { on ? set(i) : reset(i); }
+    bool test(int i) const { return (words_[i >> 6] & bit(i)) != 0; }
+
+    int  size() const { return bits_; }
+
+    int count() const {
+        int n = 0;
+        for (int w = 0; w < nwords_; ++w) n += popcount(words_[w]);
+        return n;
+    }
+
+    // First set bit at or after `from`, wrapping around past the end;
+    // -1 if no bit is set.
+    int findNext(int from) const {
+        if (bits_ == 0) return -1;
+        int w = from >> 6;
+        std::uint64_t word = words_[w] & (~std::uint64_t(0) << (from & 63));
+        for (int step = 0; step <= nwords_; ++step) {
+            // The last step revisits the first word in full: its bits at or
+            // after `from` were zero, so anything found there wrapped around.
+            if (word != 0) return (w << 6) + lowestBit(word);
+            w = (w + 1 == nwords_) ? 0 : w + 1;
+            word = words_[w];
+        }
+        return -1;
+    }
+
+private:
+    std::uint64_t* words_;
+    int            nwords_;
+    int            bits_;
+
+    static std::uint64_t bit(int i) { return std::uint64_t(1) << (i & 63); }
+
+    static int lowestBit(std::uint64_t m) {
+#if defined(_MSC_VER)
+        unsigned long idx;
+        _BitScanForward64(&idx, m);
+        return static_cast<int>(idx);
+#elif defined(__GNUC__)
+        return __builtin_ctzll(m);
+#else
+        int idx = 0;
+        while (!(m & 1)) { m >>= 1; ++idx; }
+        return idx;
+#endif
+    }
+
+    static int popcount(std::uint64_t m) {
+#if defined(__GNUC__)
+        return __builtin_popcountll(m);
+#else
+        int n = 0;
+        for (; m; m &= m - 1) ++n;
+        return n;
+#endif
+    }
+};
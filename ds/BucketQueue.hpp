@@ -0,0 +1,221 @@
+#pragma once
+#include <utility>
+#include "QueueSupport.hpp"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Bounded-key priority queue: one FIFO bucket per key level plus a bitmask
+// of the non-empty buckets. KeyOf maps an element to its level in
+// [0, Levels); higher levels are served first, equal levels in arrival order.
+// push and popMax are O(1) - the top bucket is found with a single bit scan.
+// Elements live in a slot pool threaded into per-level doubly linked lists,
+// so a pop never shifts or reallocates anything. push() returns the slot as
+// a handle that stays valid until the element leaves the queue; update and
+// erase through it are O(1). Handles are recycled after popMax/erase.
+template <typename T, typename KeyOf, int Levels>
+class BucketQueue {
+    static_assert(Levels > 0 && Levels <= 32, "BucketQueue supports 1..32 levels");
+
+public:
+    BucketQueue() : slots_(nullptr), cap_(0), len_(0), free_(-1), mask_(0), key_() {
+        for (int i = 0; i < Levels; ++i) head_[i] = tail_[i] = -1;
+        reserve(8);
+    }
+    ~BucketQueue() { delete[] slots_; }
+
+    BucketQueue(const BucketQueue&) = delete;
+    BucketQueue& operator=(const BucketQueue&) = delete;
+
+    int push(const T& v) { return emplace(v); }
+    int push(T&& v) { return emplace(std::move(v)); }
+
+    // Build the element in place from args; returns its handle like push.
+    template <typename... Args>
+    int emplace(Args&&... args) {
+        const int s = takeSlot();
+        slots_[s].value = T(std::forward<Args>(args)...);
+        link(s, key_(slots_[s].value));
+        ++len_;
+        return s;
+    }
+
+    // Add every element of [first, last); the slot pool grows at most once
+    // (see BatchGrowth). If handles is given, handles[i] receives the handle
+    // of the i-th element.
+    template <typename It>
+    void pushRange(It first, It last, int* handles = nullptr) {
+        const int k = BatchGrowth::count(first, last);
+        if (len_ + k > cap_) reserve(BatchGrowth::capacityFor(len_, k, cap_));
+        for (; first != last; ++first) {
+            const int h = push(*first);
+            if (handles) *handles++ = h;
+        }
+    }
+
+    bool popMax(T& out) {
+        if (mask_ == 0) return false;
+        const int s = head_[highestBit(mask_)];
+        out = static_cast<T&&>(slots_[s].value);
+        unlink(s);
+        releaseSlot(s);
+        --len_;
+        return true;
+    }
+
+    bool peekMax(T& out) const {
+        if (mask_ == 0) return false;
+        out = slots_[head_[highestBit(mask_)]].value;
+        return true;
+    }
+
+    // Handle of the element popMax would return; -1 if empty.
+    int topHandle() const { return mask_ != 0 ? head_[highestBit(mask_)] : -1; }
+
+    bool contains(int h) const { return h >= 0 && h < cap_ && slots_[h].level >= 0; }
+
+    // nullptr if the handle is not live
+    const T* get(int h) const { return contains(h) ? &slots_[h].value : nullptr; }
+
+    // Replace the element behind h. It keeps its place in line unless its
+    // level changes, in which case it joins the back of the new bucket.
+    bool update(int h, const T& v) {
+        if (!contains(h)) return false;
+        const int level = key_(v);
+        slots_[h].value = v;
+        if (level != slots_[h].level) {
+            unlink(h);
+            link(h, level);
+        }
+        return true;
+    }
+
+    bool erase(int h, T& out) {
+        if (!contains(h)) return false;
+        out = static_cast<T&&>(slots_[h].value);
+        unlink(h);
+        releaseSlot(h);
+        --len_;
+        return true;
+    }
+
+    bool isEmpty() const { return len_ == 0; }
+    int  size() const { return len_; }
+
+    // Visit every element (bucket order). O(n), no allocation.
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (int level = Levels - 1; level >= 0; --level)
+            for (int s = head_[level]; s >= 0; s = slots_[s].next)
+                fn(slots_[s].value);
+    }
+
+    // Visit elements in pop order without modifying the queue.
+    // limit < 0 visits everything.
+    template <typename Fn>
+    void forEachOrdered(Fn fn, int limit = -1) const {
+        forEachOrderedWithHandle([&](int, const T& v) { fn(v); }, limit);
+    }
+
+    // Same walk, but fn(handle, value) also receives the element's handle.
+    template <typename Fn>
+    void forEachOrderedWithHandle(Fn fn, int limit = -1) const {
+        int left = limit < 0 ? len_ : limit;
+        unsigned m = mask_;
+        while (m != 0 && left > 0) {
+            const int level = highestBit(m);
+            m &= ~(1u << level);
+            for (int s = head_[level]; s >= 0 && left > 0; s = slots_[s].next, --left)
+                fn(s, slots_[s].value);
+        }
+    }
+
+private:
+    struct Slot {
+        T   value;
+        int next;
+        int prev;
+        int level;   // -1 while the slot is free
+    };
+
+    Slot*    slots_;
+    int      cap_;
+    int      len_;
+    int      free_;          // head of the free-slot list
+    unsigned mask_;          // bit L set <=> bucket L non-empty
+    int      head_[Levels];
+    int      tail_[Levels];
+    KeyOf    key_;
+
+    void reserve(int n) {
+        if (n <= cap_) return;
+        Slot* newSlots = new Slot[n];
+        for (int i = 0; i < cap_; ++i) {
+            newSlots[i].value = static_cast<T&&>(slots_[i].value);
+            newSlots[i].next = slots_[i].next;
+            newSlots[i].prev = slots_[i].prev;
+            newSlots[i].level = slots_[i].level;
+        }
+        // Chain the fresh slots onto the free list.
+        for (int i = n - 1; i >= cap_; --i) {
+            newSlots[i].next = free_;
+            newSlots[i].prev = -1;
+            newSlots[i].level = -1;
+            free_ = i;
+        }
+        delete[] slots_;
+        slots_ = newSlots;
+        cap_ = n;
+    }
+
+    int takeSlot() {
+        if (free_ < 0) reserve(cap_ == 0 ? 8 : cap_ * 2);
+        const int s = free_;
+        free_ = slots_[s].next;
+        return s;
+    }
+
+    void releaseSlot(int s) {
+        slots_[s].value = T();
+        slots_[s].level = -1;
+        slots_[s].next = free_;
+        free_ = s;
+    }
+
+    // Append slot s to the back of bucket `level`.
+    void link(int s, int level) {
+        slots_[s].level = level;
+        slots_[s].next = -1;
+        slots_[s].prev = tail_[level];
+        if (tail_[level] < 0) head_[level] = s;
+        else slots_[tail_[level]].next = s;
+        tail_[level] = s;
+        mask_ |= 1u << level;
+    }
+
+    void unlink(int s) {
+        const int level = slots_[s].level;
+        const int prev = slots_[s].prev;
+        const int next = slots_[s].next;
+        if (prev < 0) head_[level] = next;
+        else slots_[prev].next = next;
+        if (next < 0) tail_[level] = prev;
+        else slots_[next].prev = prev;
+        if (head_[level] < 0) mask_ &= ~(1u << level);
+    }
+
+    static int highestBit(unsigned m) {
+#if defined(_MSC_VER)
+        unsigned long idx;
+        _BitScanReverse(&idx, m);
+        return static_cast<int>(idx);
+#elif defined(__GNUC__)
+        return 31 - __builtin_clz(m);
+#else
+        int idx = 0;
+        while (m >>= 1) ++idx;
+        return idx;
+#endif
+    }
+};
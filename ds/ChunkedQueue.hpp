@@ -0,0 +1,151 @@
+#pragma once
+
+#include <new>
+#include <utility>
+
+// FIFO queue stored as a linked list of fixed-size blocks (an unrolled
+// list): ChunkSize elements share one allocation and sit next to each other
+// in memory. Same enqueue/dequeue/front/isEmpty interface as LinkedQueue,
+// so one can replace the other.
+// A block emptied by dequeue is kept on a short spare list and reused by the
+// next enqueue that needs one, so a queue that stays around the same size
+// stops allocating altogether.
+template <typename T, int ChunkSize = 32>
+class ChunkedQueue {
+    static_assert(ChunkSize > 0, "ChunkedQueue needs at least one slot per block");
+
+public:
+    ChunkedQueue()
+        : head(nullptr), tail(nullptr), headIdx(0), tailIdx(0), count(0),
+          spare(nullptr), spareCount(0) {}
+
+    ~ChunkedQueue() {
+        for (Chunk* c = head; c; c = c->next) {
+            const int from = (c == head) ? headIdx : 0;
+            const int to = (c == tail) ? tailIdx : ChunkSize;
+            for (int i = from; i < to; ++i) c->item(i)->~T();
+        }
+        freeChunks(head);
+        freeChunks(spare);
+    }
+
+    ChunkedQueue(const ChunkedQueue&) = delete;
+    ChunkedQueue& operator=(const ChunkedQueue&) = delete;
+
+    void enqueue(const T& v) {
+        new (slotForPush()) T(v);
+        ++tailIdx;
+        ++count;
+    }
+
+    void enqueue(T&& v) {
+        new (slotForPush()) T(std::move(v));
+        ++tailIdx;
+        ++count;
+    }
+
+    bool dequeue(T& out) {
+        if (count == 0) return false;
+        T* item = head->item(headIdx);
+        out = std::move(*item);
+        item->~T();
+        ++headIdx;
+        --count;
+        if (count == 0) {
+            // Keep the single block; rewind it for the next burst.
+            headIdx = tailIdx = 0;
+        }
+        else if (headIdx == ChunkSize) {
+            Chunk* done = head;
+            head = head->next;
+            headIdx = 0;
+            retire(done);
+        }
+        return true;
+    }
+
+    bool front(T& out) const {
+        if (count == 0) return false;
+        out = *head->item(headIdx);
+        return true;
+    }
+
+    bool isEmpty() const { return count == 0; }
+    int  size() const { return count; }
+
+    // Visit every element front to back without modifying the queue.
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (const Chunk* c = head; c; c = c->next) {
+            const int from = (c == head) ? headIdx : 0;
+            const int to = (c == tail) ? tailIdx : ChunkSize;
+            for (int i = from; i < to; ++i) fn(*c->item(i));
+        }
+    }
+
+private:
+    struct Chunk {
+        Chunk* next;
+        alignas(T) unsigned char storage[sizeof(T) * ChunkSize];
+
+        T* item(int i) { return reinterpret_cast<T*>(storage) + i; }
+        const T* item(int i) const { return reinterpret_cast<const T*>(storage) + i; }
+    };
+
+    // Blocks kept for reuse; beyond this, emptied blocks are freed so a
+    // one-off surge does not pin its memory.
+    static const int MaxSpare = 4;
+
+    Chunk* head;      // oldest block, holds the front at headIdx
+    Chunk* tail;      // newest block, next free slot at tailIdx
+    int    headIdx;
+    int    tailIdx;
+    int    count;
+    Chunk* spare;
+    int    spareCount;
+
+    T* slotForPush() {
+        if (!tail) {
+            head = tail = takeChunk();
+        }
+        else if (tailIdx == ChunkSize) {
+            Chunk* c = takeChunk();
+            tail->next = c;
+            tail = c;
+            tailIdx = 0;
+        }
+        return tail->item(tailIdx);
+    }
+
+    Chunk* takeChunk() {
+        Chunk* c = spare;
+        if (c) {
+            spare = c->next;
+            --spareCount;
+        }
+        else {
+            c = static_cast<Chunk*>(::operator new(sizeof(Chunk)));
+        }
+        c->next = nullptr;
+        return c;
+    }
+
+    void retire(Chunk* c) {
+        if (spareCount < MaxSpare) {
+            c->next = spare;
+            spare = c;
+            ++spareCount;
+        }
+        else {
+            ::operator delete(c);
+        }
+    }
+
+    static void freeChunks(Chunk* c) {
+        while (c) {
+            Chunk* next = c->next;
+            ::operator delete(c);
+            c = next;
+        }
+    }
+};
@@ -2,8 +2,14 @@
 #define CIRCULARQUEUE_HPP
 
 #include <iostream>
+#include <new>
 #include <stdexcept>
 #include <string>
+#include <utility>
+
+// Pass as MAX_SIZE for a ring that grows on demand (see the specialization
+// below). Any other MAX_SIZE is a fixed array, e.g. for embedded targets.
+constexpr int CIRCULAR_GROWABLE = 0;
 
 template <typename T, int MAX_SIZE = 10>
 class CircularQueue {
@@ -74,13 +80,50 @@ public:
         return data[front];
     }
 
+    // Element i positions behind the front (0 = front)
+    T& at(int i) {
+        return data[(front + i) % MAX_SIZE];
+    }
+
+    const T& at(int i) const {
+        return data[(front + i) % MAX_SIZE];
+    }
+
     // Rotate front element to back
     void rotateOnce() {
-        if (isEmpty() || count == 1) {
-            return; 
+        rotate(1);
+    }
+
+    // Rotate the front k places towards the back. A full buffer only moves
+    // its front/rear offsets (O(1)); otherwise min(k, count - k) elements are
+    // moved - never copied - across the gap.
+    void rotate(int k) {
+        if (count <= 1) {
+            return;
+        }
+        k %= count;
+        if (k < 0) k += count;
+        if (k == 0) return;
+
+        if (isFull()) {
+            front = (front + k) % MAX_SIZE;
+            rear = (rear + k) % MAX_SIZE;
+            return;
+        }
+        if (k <= count - k) {
+            for (int i = 0; i < k; i++) {
+                rear = (rear + 1) % MAX_SIZE;
+                data[rear] = std::move(data[front]);
+                front = (front + 1) % MAX_SIZE;
+            }
+        }
+        else {
+            for (int i = 0; i < count - k; i++) {
+                front = (front - 1 + MAX_SIZE) % MAX_SIZE;
+                data[front] = std::move(data[rear]);
+                rear = (rear - 1 + MAX_SIZE) % MAX_SIZE;
+            }
         }
-        T frontItem = dequeue();
-        enqueue(frontItem);
     }
 
     // Display queue contents
@@ -99,4 +142,240 @@ public:
     }
 };
 
-#endif
\ No newline at end of file
+// Growable ring buffer. Capacity is always a power of two so positions wrap
+// with a mask instead of '%'. Storage is raw memory: only occupied slots hold
+// constructed objects, and growth moves them into the new block in queue
+// order.
+template <typename T>
+class CircularQueue<T, CIRCULAR_GROWABLE> {
+private:
+    T* data;
+    int capacity;
+    int mask;
+    int front;
+    int count;
+
+    int slot(int i) const { return (front + i) & mask; }
+
+    void relocate(int newCapacity) {
+        T* fresh = static_cast<T*>(::operator new(sizeof(T) * static_cast<std::size_t>(newCapacity)));
+        for (int i = 0; i < count; i++) {
+            T& item = data[slot(i)];
+            new (fresh + i) T(std::move(item));
+            item.~T();
+        }
+        ::operator delete(data);
+        data = fresh;
+        capacity = newCapacity;
+        mask = newCapacity - 1;
+        front = 0;
+    }
+
+public:
+    // Constructor
+    explicit CircularQueue(int initialCapacity = 8)
+        : data(nullptr), capacity(0), mask(0), front(0), count(0) {
+        int cap = 1;
+        while (cap < initialCapacity) cap <<= 1;
+        relocate(cap);
+    }
+
+    ~CircularQueue() {
+        while (count > 0) {
+            data[front].~T();
+            front = (front + 1) & mask;
+            count--;
+        }
+        ::operator delete(data);
+    }
+
+    CircularQueue(const CircularQueue&) = delete;
+    CircularQueue& operator=(const CircularQueue&) = delete;
+
+    bool isEmpty() const {
+        return count == 0;
+    }
+
+    // Never full: enqueue grows the buffer instead.
+    bool isFull() const {
+        return false;
+    }
+
+    int getCount() const {
+        return count;
+    }
+
+    int getCapacity() const {
+        return capacity;
+    }
+
+    // Make room for at least n elements without further growth.
+    void reserve(int n) {
+        if (n <= capacity) return;
+        int cap = capacity;
+        while (cap < n) cap <<= 1;
+        relocate(cap);
+    }
+
+    // Add element to queue, doubling the buffer when it is full
+    void enqueue(const T& item) {
+        if (count == capacity) relocate(capacity * 2);
+        new (data + slot(count)) T(item);
+        count++;
+    }
+
+    void enqueue(T&& item) {
+        if (count == capacity) relocate(capacity * 2);
+        new (data + slot(count)) T(std::move(item));
+        count++;
+    }
+
+    // Remove element from queue
+    T dequeue() {
+        if (isEmpty()) {
+            throw std::underflow_error("Queue is empty");
+        }
+        T item(std::move(data[front]));
+        data[front].~T();
+        front = (front + 1) & mask;
+        count--;
+        return item;
+    }
+
+    // Peek at front element
+    T& peekFront() {
+        if (isEmpty()) {
+            throw std::underflow_error("Queue is empty");
+        }
+        return data[front];
+    }
+
+    const T& peekFront() const {
+        if (isEmpty()) {
+            throw std::underflow_error("Queue is empty");
+        }
+        return data[front];
+    }
+
+    // Element i positions behind the front (0 = front)
+    T& at(int i) {
+        return data[slot(i)];
+    }
+
+    const T& at(int i) const {
+        return data[slot(i)];
+    }
+
+    // Physical slot of element i, and the reverse. A slot stays put until
+    // the element is moved by rotate/removeAt (which report it) or the
+    // buffer grows (getCapacity changes), so it can be kept in an index.
+    int slotOf(int i) const {
+        return slot(i);
+    }
+
+    int positionOfSlot(int s) const {
+        return (s - front) & mask;
+    }
+
+    T& atSlot(int s) {
+        return data[s];
+    }
+
+    const T& atSlot(int s) const {
+        return data[s];
+    }
+
+    // Rotate front element to back
+    void rotateOnce() {
+        rotate(1);
+    }
+
+    // Rotate the front k places towards the back. A full buffer only moves
+    // its front offset (O(1)); otherwise min(k, count - k) elements are
+    // moved - never copied - across the gap.
+    void rotate(int k) {
+        rotate(k, [](const T&, int) {});
+    }
+
+    // Same, calling moved(item, newSlot) for every element that changed slot.
+    template <typename OnMove>
+    void rotate(int k, OnMove moved) {
+        if (count <= 1) {
+            return;
+        }
+        k %= count;
+        if (k < 0) k += count;
+        if (k == 0) return;
+
+        if (count == capacity) {
+            front = (front + k) & mask;
+            return;
+        }
+        if (k <= count - k) {
+            for (int i = 0; i < k; i++) {
+                T& item = data[front];
+                T* dest = data + slot(count);
+                new (dest) T(std::move(item));
+                item.~T();
+                front = (front + 1) & mask;
+                moved(*dest, static_cast<int>(dest - data));
+            }
+        }
+        else {
+            for (int i = 0; i < count - k; i++) {
+                T& item = data[slot(count - 1)];
+                front = (front - 1) & mask;
+                new (data + front) T(std::move(item));
+                item.~T();
+                moved(data[front], front);
+            }
+        }
+    }
+
+    // Take element i out of the ring, closing the gap from whichever end is
+    // nearer: at most count / 2 moves, each reported as moved(item, newSlot).
+    template <typename OnMove>
+    T removeAt(int i, OnMove moved) {
+        if (i < 0 || i >= count) {
+            throw std::out_of_range("Queue index out of range");
+        }
+        T item(std::move(data[slot(i)]));
+        if (i < count - 1 - i) {
+            for (int j = i; j > 0; j--) {
+                data[slot(j)] = std::move(data[slot(j - 1)]);
+                moved(data[slot(j)], slot(j));
+            }
+            data[front].~T();
+            front = (front + 1) & mask;
+        }
+        else {
+            for (int j = i; j < count - 1; j++) {
+                data[slot(j)] = std::move(data[slot(j + 1)]);
+                moved(data[slot(j)], slot(j));
+            }
+            data[slot(count - 1)].~T();
+        }
+        count--;
+        return item;
+    }
+
+    T removeAt(int i) {
+        return removeAt(i, [](const T&, int) {});
+    }
+
+    // Display queue contents
+    void display(std::ostream& os) const {
+        if (isEmpty()) {
+            os << "[No ambulances registered]" << std::endl;
+            return;
+        }
+
+        os << "--- Current Ambulance Rotation ---" << std::endl;
+        for (int i = 0; i < count; i++) {
+            os << (i + 1) << ") " << data[slot(i)] << std::endl;
+        }
+        os << "----------------------------------" << std::endl;
+    }
+};
+
+#endif
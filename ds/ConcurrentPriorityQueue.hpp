@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "PriorityQueue.hpp"
+
+// Relaxed multi-producer/multi-consumer priority queue (a "MultiQueue").
+// Elements are spread over Shards independent heaps, each behind its own
+// lock. push locks one random shard; tryPopMax locks two random shards and
+// takes the better of their tops. Threads rarely meet on the same lock, so
+// throughput scales with the number of threads, at the price of order
+// being approximate: a pop returns one of the best elements, not always the
+// single best one. If both sampled shards are empty every shard is tried,
+// so an element is never stranded.
+template <typename T, typename Compare = DefaultGreater<T>, int Shards = 8>
+class ConcurrentPriorityQueue {
+    static_assert(Shards >= 2, "ConcurrentPriorityQueue needs at least two shards");
+
+public:
+    ConcurrentPriorityQueue() : count_(0), cmp_() {}
+
+    ConcurrentPriorityQueue(const ConcurrentPriorityQueue&) = delete;
+    ConcurrentPriorityQueue& operator=(const ConcurrentPriorityQueue&) = delete;
+
+    void push(const T& v) { emplace(v); }
+    void push(T&& v) { emplace(std::move(v)); }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        Shard& s = shards_[randomShard()];
+        {
+            std::lock_guard<std::mutex> guard(s.lock);
+            s.heap.emplace(std::forward<Args>(args)...);
+        }
+        count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Never blocks waiting for work; false when every shard was empty.
+    bool tryPopMax(T& out) {
+        if (count_.load(std::memory_order_relaxed) == 0) return false;
+
+        int a = randomShard();
+        int b = randomShard();
+        if (a == b) b = (a + 1) % Shards;
+        if (a > b) std::swap(a, b); // fixed lock order, no deadlock
+
+        {
+            std::lock_guard<std::mutex> ga(shards_[a].lock);
+            std::lock_guard<std::mutex> gb(shards_[b].lock);
+            PriorityQueue<T, Compare>& ha = shards_[a].heap;
+            PriorityQueue<T, Compare>& hb = shards_[b].heap;
+            if (!ha.isEmpty() || !hb.isEmpty()) {
+                const bool takeA = hb.isEmpty() || (!ha.isEmpty() && !cmp_(hb.top(), ha.top()));
+                (takeA ? ha : hb).popMax(out);
+                count_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        for (int i = 0; i < Shards; ++i) {
+            std::lock_guard<std::mutex> guard(shards_[i].lock);
+            if (shards_[i].heap.popMax(out)) {
+                count_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Exact only while no other thread is pushing or popping.
+    int  sizeApprox() const { return count_.load(std::memory_order_relaxed); }
+    bool isEmpty() const { return sizeApprox() == 0; }
+
+private:
+    // One cache line (or more) per shard so neighbouring locks don't share.
+    struct alignas(64) Shard {
+        std::mutex                lock;
+        PriorityQueue<T, Compare> heap;
+    };
+
+    Shard            shards_[Shards];
+    std::atomic<int> count_;
+    Compare          cmp_;
+
+    static int randomShard() {
+        thread_local unsigned state =
+            static_cast<unsigned>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return static_cast<int>(state % Shards);
+    }
+};
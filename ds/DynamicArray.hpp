@@ -0,0 +1,62 @@
+#pragma once
+
+#include <new>
+#include <utility>
+
+// Minimal growable array (the project keeps to its own containers).
+// Geometric growth; elements are moved, not copied, when the block grows.
+template <typename T>
+class DynamicArray {
+public:
+    DynamicArray() : arr_(nullptr), cap_(0), len_(0) {}
+    ~DynamicArray() {
+        clear();
+        ::operator delete(arr_);
+    }
+
+    DynamicArray(const DynamicArray&) = delete;
+    DynamicArray& operator=(const DynamicArray&) = delete;
+
+    void push(const T& v) { emplace(v); }
+    void push(T&& v) { emplace(std::move(v)); }
+
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        if (len_ >= cap_) reserve(cap_ == 0 ? 8 : cap_ * 2);
+        new (arr_ + len_) T(std::forward<Args>(args)...);
+        return arr_[len_++];
+    }
+
+    void pop() { arr_[--len_].~T(); }
+
+    void reserve(int n) {
+        if (n <= cap_) return;
+        T* newArr = static_cast<T*>(::operator new(sizeof(T) * static_cast<std::size_t>(n)));
+        for (int i = 0; i < len_; ++i) {
+            new (newArr + i) T(std::move(arr_[i]));
+            arr_[i].~T();
+        }
+        ::operator delete(arr_);
+        arr_ = newArr;
+        cap_ = n;
+    }
+
+    void clear() {
+        for (int i = 0; i < len_; ++i) arr_[i].~T();
+        len_ = 0;
+    }
+
+    T&       operator[](int i) { return arr_[i]; }
+    const T& operator[](int i) const { return arr_[i]; }
+    T&       back() { return arr_[len_ - 1]; }
+
+    T*       data() { return arr_; }
+    const T* data() const { return arr_; }
+    int      size() const { return len_; }
+    bool     isEmpty() const { return len_ == 0; }
+
+private:
+    T*  arr_;
+    int cap_;
+    int len_;
+};
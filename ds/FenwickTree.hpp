@@ -0,0 +1,38 @@
+#pragma once
+
+// Binary indexed tree over [0, n): point add and prefix sum in O(log n).
+// Used to count live entries before a given ticket, e.g. "how many people
+// are ahead of me" in a queue that also loses people from the middle.
+class FenwickTree {
+public:
+    explicit FenwickTree(int n = 0) : tree_(nullptr), n_(0) { reset(n); }
+    ~FenwickTree() { delete[] tree_; }
+
+    FenwickTree(const FenwickTree&) = delete;
+    FenwickTree& operator=(const FenwickTree&) = delete;
+
+    // Resize to n entries, all zero.
+    void reset(int n) {
+        delete[] tree_;
+        n_ = n;
+        tree_ = new int[n + 1];
+        for (int i = 0; i <= n; ++i) tree_[i] = 0;
+    }
+
+    void add(int i, int delta) {
+        for (++i; i <= n_; i += i & -i) tree_[i] += delta;
+    }
+
+    // Sum of entries [0, i).
+    int prefix(int i) const {
+        int sum = 0;
+        for (; i > 0; i -= i & -i) sum += tree_[i];
+        return sum;
+    }
+
+    int size() const { return n_; }
+
+private:
+    int* tree_;   // 1-based
+    int  n_;
+};
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+// Open-addressing hash map for lookup indexes (code -> slot, id -> node).
+// Linear probing over a power-of-two table kept at most 3/4 full; erase
+// shifts the following entries back instead of leaving tombstones, so
+// lookups stay short however many inserts and erases a module does.
+// Key and Value must be default-constructible.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class HashIndex {
+public:
+    HashIndex() : slots_(nullptr), cap_(0), len_(0), hash_() {
+        rehash(16);
+    }
+    ~HashIndex() { delete[] slots_; }
+
+    HashIndex(const HashIndex&) = delete;
+    HashIndex& operator=(const HashIndex&) = delete;
+
+    // Add key -> value. False (and no change) if the key is already present.
+    bool insert(const Key& key, const Value& value) {
+        if ((len_ + 1) * 4 > cap_ * 3) rehash(cap_ * 2);
+        int i = home(key);
+        while (slots_[i].used) {
+            if (slots_[i].key == key) return false;
+            i = (i + 1) & (cap_ - 1);
+        }
+        slots_[i].key = key;
+        slots_[i].value = value;
+        slots_[i].used = true;
+        ++len_;
+        return true;
+    }
+
+    // Insert or overwrite.
+    void assign(const Key& key, const Value& value) {
+        Value* v = find(key);
+        if (v) *v = value;
+        else insert(key, value);
+    }
+
+    // nullptr if the key is not present
+    Value* find(const Key& key) {
+        const int i = locate(key);
+        return i < 0 ? nullptr : &slots_[i].value;
+    }
+
+    const Value* find(const Key& key) const {
+        const int i = locate(key);
+        return i < 0 ? nullptr : &slots_[i].value;
+    }
+
+    bool contains(const Key& key) const { return locate(key) >= 0; }
+
+    bool erase(const Key& key) {
+        int hole = locate(key);
+        if (hole < 0) return false;
+        // Backward-shift: pull later entries of the probe run into the hole
+        // unless that would move them in front of their home slot.
+        int i = hole;
+        while (true) {
+            i = (i + 1) & (cap_ - 1);
+            if (!slots_[i].used) break;
+            const int h = home(slots_[i].key);
+            if (((i - h) & (cap_ - 1)) >= ((i - hole) & (cap_ - 1))) {
+                slots_[hole].key = static_cast<Key&&>(slots_[i].key);
+                slots_[hole].value = static_cast<Value&&>(slots_[i].value);
+                hole = i;
+            }
+        }
+        slots_[hole].key = Key();
+        slots_[hole].value = Value();
+        slots_[hole].used = false;
+        --len_;
+        return true;
+    }
+
+    void clear() {
+        for (int i = 0; i < cap_; ++i) {
+            if (!slots_[i].used) continue;
+            slots_[i].key = Key();
+            slots_[i].value = Value();
+            slots_[i].used = false;
+        }
+        len_ = 0;
+    }
+
+    // Make room for n entries without rehashing.
+    void reserve(int n) {
+        int cap = cap_;
+        while (n * 4 > cap * 3) cap *= 2;
+        if (cap != cap_) rehash(cap);
+    }
+
+    bool isEmpty() const { return len_ == 0; }
+    int  size() const { return len_; }
+
+    // Visit every entry as fn(key, value), in table order.
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (int i = 0; i < cap_; ++i)
+            if (slots_[i].used) fn(slots_[i].key, slots_[i].value);
+    }
+
+private:
+    struct Slot {
+        Key   key{};
+        Value value{};
+        bool  used = false;
+    };
+
+    Slot* slots_;
+    int   cap_;
+    int   len_;
+    Hash  hash_;
+
+    // std::hash is the identity for integers; mix it so sequential ids do
+    // not fill one contiguous run of the table.
+    int home(const Key& key) const {
+        unsigned long long h = static_cast<unsigned long long>(hash_(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<int>(h & static_cast<unsigned long long>(cap_ - 1));
+    }
+
+    int locate(const Key& key) const {
+        int i = home(key);
+        while (slots_[i].used) {
+            if (slots_[i].key == key) return i;
+            i = (i + 1) & (cap_ - 1);
+        }
+        return -1;
+    }
+
+    void rehash(int newCap) {
+        Slot* old = slots_;
+        const int oldCap = cap_;
+        slots_ = new Slot[newCap];
+        cap_ = newCap;
+        for (int i = 0; i < oldCap; ++i) {
+            if (!old[i].used) continue;
+            int j = home(old[i].key);
+            while (slots_[j].used) j = (j + 1) & (cap_ - 1);
+            slots_[j].key = static_cast<Key&&>(old[i].key);
+            slots_[j].value = static_cast<Value&&>(old[i].value);
+            slots_[j].used = true;
+        }
+        delete[] old;
+    }
+};
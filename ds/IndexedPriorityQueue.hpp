@@ -0,0 +1,223 @@
+#pragma once
+
+#include <utility>
+#include "PriorityQueue.hpp" // DefaultGreater
+#include "QueueSupport.hpp"
+
+// Addressable binary heap. push() returns a handle that stays valid until the
+// element leaves the queue, so an element can be changed or removed in
+// O(log n) without a rebuild. Handles are recycled after popMax/erase.
+//
+// Values never move once pushed; the heap orders slot ids instead:
+//   heap_[0..len_)   live slots in heap order
+//   heap_[len_..cap_) free slots, ready for the next push
+//   pos_[slot]       position of slot inside heap_
+template <typename T, typename Compare = DefaultGreater<T>>
+class IndexedPriorityQueue {
+public:
+    IndexedPriorityQueue()
+        : vals_(nullptr), heap_(nullptr), pos_(nullptr), cap_(0), len_(0), cmp_() {
+        reserve(8);
+    }
+    ~IndexedPriorityQueue() {
+        delete[] vals_;
+        delete[] heap_;
+        delete[] pos_;
+    }
+
+    IndexedPriorityQueue(const IndexedPriorityQueue&) = delete;
+    IndexedPriorityQueue& operator=(const IndexedPriorityQueue&) = delete;
+
+    int push(const T& v) { return emplace(v); }
+    int push(T&& v) { return emplace(std::move(v)); }
+
+    // Build the element in place from args; returns its handle like push.
+    template <typename... Args>
+    int emplace(Args&&... args) {
+        if (len_ >= cap_) grow();
+        const int h = heap_[len_];
+        vals_[h] = T(std::forward<Args>(args)...);
+        siftUp(len_++);
+        return h;
+    }
+
+    // Add every element of [first, last) with a single reservation; large
+    // batches are heapified bottom-up in O(n + k) (see
+    // PriorityQueue::pushRange). If handles is given, handles[i] receives
+    // the handle of the i-th element.
+    template <typename It>
+    void pushRange(It first, It last, int* handles = nullptr) {
+        const int k = BatchGrowth::count(first, last);
+        if (k == 0) return;
+        if (len_ + k > cap_) reserve(BatchGrowth::capacityFor(len_, k, cap_));
+
+        const bool rebuild = k >= len_;
+        for (; first != last; ++first) {
+            if (handles) *handles++ = heap_[len_];
+            vals_[heap_[len_]] = *first;
+            if (!rebuild) siftUp(len_);
+            ++len_;
+        }
+        if (rebuild) {
+            for (int i = len_ > 1 ? parent(len_ - 1) : -1; i >= 0; --i) siftDown(i);
+        }
+    }
+
+    bool popMax(T& out) {
+        if (len_ == 0) return false;
+        const int h = heap_[0];
+        out = static_cast<T&&>(vals_[h]);
+        removeAt(0);
+        return true;
+    }
+
+    bool peekMax(T& out) const {
+        if (len_ == 0) return false;
+        out = vals_[heap_[0]];
+        return true;
+    }
+
+    // Handle of the element popMax would return; -1 if empty.
+    int topHandle() const { return len_ > 0 ? heap_[0] : -1; }
+
+    bool contains(int h) const { return h >= 0 && h < cap_ && pos_[h] < len_; }
+
+    // nullptr if the handle is not live
+    const T* get(int h) const { return contains(h) ? &vals_[h] : nullptr; }
+
+    // Replace the element behind h and restore heap order. O(log n).
+    bool update(int h, const T& v) {
+        if (!contains(h)) return false;
+        vals_[h] = v;
+        siftUp(pos_[h]);
+        siftDown(pos_[h]);
+        return true;
+    }
+
+    // Remove the element behind h. O(log n).
+    bool erase(int h, T& out) {
+        if (!contains(h)) return false;
+        out = static_cast<T&&>(vals_[h]);
+        removeAt(pos_[h]);
+        return true;
+    }
+
+    bool isEmpty() const { return len_ == 0; }
+    int  size() const { return len_; }
+
+    // Visit every element in heap order. O(n), no allocation.
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (int i = 0; i < len_; ++i) fn(vals_[heap_[i]]);
+    }
+
+    // Visit elements best-first without touching the heap (see
+    // PriorityQueue::forEachOrdered). limit < 0 visits everything.
+    template <typename Fn>
+    void forEachOrdered(Fn fn, int limit = -1) const {
+        forEachOrderedWithHandle([&](int, const T& v) { fn(v); }, limit);
+    }
+
+    // Same walk, but fn(handle, value) also receives the element's handle.
+    template <typename Fn>
+    void forEachOrderedWithHandle(Fn fn, int limit = -1) const {
+        if (len_ == 0 || limit == 0) return;
+        const int k = (limit < 0 || limit > len_) ? len_ : limit;
+
+        IndexFrontier frontier(k + 1, [this](int a, int b) { return higher(a, b); });
+        frontier.push(0);
+
+        for (int visited = 0; visited < k && !frontier.isEmpty(); ++visited) {
+            const int i = frontier.pop();
+            fn(heap_[i], vals_[heap_[i]]);
+            if (left(i) < len_)  frontier.push(left(i));
+            if (right(i) < len_) frontier.push(right(i));
+        }
+    }
+
+private:
+    T*      vals_;
+    int*    heap_;
+    int*    pos_;
+    int     cap_;
+    int     len_;
+    Compare cmp_;
+
+    void reserve(int n) {
+        if (n <= cap_) return;
+        T*   newVals = new T[n];
+        int* newHeap = new int[n];
+        int* newPos = new int[n];
+        for (int i = 0; i < cap_; ++i) {
+            newVals[i] = static_cast<T&&>(vals_[i]);
+            newHeap[i] = heap_[i];
+            newPos[i] = pos_[i];
+        }
+        for (int i = cap_; i < n; ++i) {
+            newHeap[i] = i;
+            newPos[i] = i;
+        }
+        delete[] vals_;
+        delete[] heap_;
+        delete[] pos_;
+        vals_ = newVals;
+        heap_ = newHeap;
+        pos_ = newPos;
+        cap_ = n;
+    }
+
+    void grow() { reserve(cap_ == 0 ? 8 : cap_ * 2); }
+
+    static int parent(int i) { return (i - 1) / 2; }
+    static int left(int i) { return 2 * i + 1; }
+    static int right(int i) { return 2 * i + 2; }
+
+    bool higher(int i, int j) const { return cmp_(vals_[heap_[i]], vals_[heap_[j]]); }
+
+    void place(int i, int slot) {
+        heap_[i] = slot;
+        pos_[slot] = i;
+    }
+
+    void swapAt(int i, int j) {
+        const int si = heap_[i];
+        place(i, heap_[j]);
+        place(j, si);
+    }
+
+    // Move the slot at heap position i past the live range and fix the heap.
+    void removeAt(int i) {
+        const int last = --len_;
+        const int slot = heap_[i];
+        swapAt(i, last);
+        vals_[slot] = T();
+        if (i < len_) {
+            siftUp(i);
+            siftDown(i);
+        }
+    }
+
+    void siftUp(int i) {
+        while (i > 0) {
+            int p = parent(i);
+            if (higher(i, p)) {
+                swapAt(i, p);
+                i = p;
+            }
+            else break;
+        }
+    }
+
+    void siftDown(int i) {
+        while (true) {
+            int l = left(i), r = right(i), largest = i;
+            if (l < len_ && higher(l, largest)) largest = l;
+            if (r < len_ && higher(r, largest)) largest = r;
+            if (largest != i) {
+                swapAt(i, largest);
+                i = largest;
+            }
+            else break;
+        }
+    }
+};
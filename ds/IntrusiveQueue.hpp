@@ -0,0 +1,62 @@
+#pragma once
+
+// Doubly linked FIFO over caller-owned nodes. A node type opts in by
+// deriving from IntrusiveHook<Node>; the queue only threads the prev/next
+// pointers and never allocates or frees. Because a node knows its
+// neighbours, one found through an outside index (e.g. a HashIndex from
+// id to node) can be unlinked from the middle in O(1).
+template <typename Node>
+struct IntrusiveHook {
+    Node* prev = nullptr;
+    Node* next = nullptr;
+};
+
+template <typename Node>
+class IntrusiveQueue {
+public:
+    IntrusiveQueue() : head_(nullptr), tail_(nullptr), len_(0) {}
+
+    IntrusiveQueue(const IntrusiveQueue&) = delete;
+    IntrusiveQueue& operator=(const IntrusiveQueue&) = delete;
+
+    void pushBack(Node* n) {
+        n->prev = tail_;
+        n->next = nullptr;
+        if (tail_) tail_->next = n;
+        else head_ = n;
+        tail_ = n;
+        ++len_;
+    }
+
+    // Unlink and return the front node; nullptr if empty.
+    Node* popFront() {
+        Node* n = head_;
+        if (n) remove(n);
+        return n;
+    }
+
+    // Unlink n, which must currently be in this queue. O(1).
+    void remove(Node* n) {
+        if (n->prev) n->prev->next = n->next;
+        else head_ = n->next;
+        if (n->next) n->next->prev = n->prev;
+        else tail_ = n->prev;
+        n->prev = n->next = nullptr;
+        --len_;
+    }
+
+    Node* front() const { return head_; }
+    bool  isEmpty() const { return head_ == nullptr; }
+    int   size() const { return len_; }
+
+    // Visit every node front to back. fn must not unlink the node it gets.
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (const Node* n = head_; n; n = n->next) fn(*n);
+    }
+
+private:
+    Node* head_;
+    Node* tail_;
+    int   len_;
+};
@@ -1,39 +1,69 @@
 #pragma once
 
-template <typename T>
+#include <new>
+#include <utility>
+#include "PoolAllocator.hpp"
+
+// Singly linked FIFO. Alloc supplies the node memory: HeapNodeAllocator
+// (new/delete per node) or PoolNodeAllocator (recycled fixed-size blocks).
+// Moving a queue, or splicing one onto another, relinks the chain in O(1)
+// without touching the elements.
+template <typename T, typename Alloc = HeapNodeAllocator>
 class LinkedQueue {
 public:
-    LinkedQueue() : head(nullptr), tail(nullptr) {}
+    LinkedQueue() noexcept : head(nullptr), tail(nullptr) {}
 
-    ~LinkedQueue() {
-        while (head) {
-            Node* n = head;
-            head = head->next;
-            delete n;
-        }
+    LinkedQueue(LinkedQueue&& other) noexcept : head(other.head), tail(other.tail) {
+        other.head = other.tail = nullptr;
     }
 
-    void enqueue(const T& v) {
-        Node* n = new Node{ v, nullptr };
-        if (!tail) {
-            head = tail = n;
-        }
-        else {
-            tail->next = n;
-            tail = n;
+    LinkedQueue& operator=(LinkedQueue&& other) noexcept {
+        if (this != &other) {
+            clear();
+            head = other.head;
+            tail = other.tail;
+            other.head = other.tail = nullptr;
         }
+        return *this;
     }
 
+    LinkedQueue(const LinkedQueue&) = delete;
+    LinkedQueue& operator=(const LinkedQueue&) = delete;
+
+    ~LinkedQueue() { clear(); }
+
+    void enqueue(const T& v) { link(makeNode(v)); }
+    void enqueue(T&& v) { link(makeNode(std::move(v))); }
+
+    // Construct the element in its node from args.
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        Node* n = makeNode(std::forward<Args>(args)...);
+        link(n);
+        return n->data;
+    }
+
+    // Moves the front element into out.
     bool dequeue(T& out) {
         if (!head) return false;
         Node* n = head;
-        out = n->data;
+        out = std::move(n->data);
         head = head->next;
         if (!head) tail = nullptr;
-        delete n;
+        freeNode(n);
         return true;
     }
 
+    // Append all of other's elements, in order, and leave other empty.
+    // O(1): the chain is relinked, nothing is copied or allocated.
+    void splice(LinkedQueue&& other) noexcept {
+        if (this == &other || !other.head) return;
+        if (tail) tail->next = other.head;
+        else head = other.head;
+        tail = other.tail;
+        other.head = other.tail = nullptr;
+    }
+
     bool front(T& out) const {
         if (!head) return false;
         out = head->data;
@@ -42,6 +72,12 @@ public:
 
     bool isEmpty() const { return head == nullptr; }
 
+    // Visit every element front to back without modifying the queue.
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (const Node* n = head; n; n = n->next) fn(n->data);
+    }
+
 private:
     struct Node {
         T data;
@@ -50,4 +86,41 @@ private:
 
     Node* head;
     Node* tail;
+
+    void link(Node* n) noexcept {
+        if (!tail) {
+            head = tail = n;
+        }
+        else {
+            tail->next = n;
+            tail = n;
+        }
+    }
+
+    void clear() noexcept {
+        while (head) {
+            Node* n = head;
+            head = head->next;
+            freeNode(n);
+        }
+        tail = nullptr;
+    }
+
+    template <typename... Args>
+    static Node* makeNode(Args&&... args) {
+        Node* n = Alloc::template allocate<Node>();
+        try {
+            new (n) Node{ T(std::forward<Args>(args)...), nullptr };
+        }
+        catch (...) {
+            Alloc::template deallocate<Node>(n);
+            throw;
+        }
+        return n;
+    }
+
+    static void freeNode(Node* n) noexcept {
+        n->~Node();
+        Alloc::template deallocate<Node>(n);
+    }
 };
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <iosfwd>
+#include <new>
 #include <ostream>
+#include "PoolAllocator.hpp"
 
-template <typename T>
+// Singly linked LIFO. Alloc supplies the node memory: HeapNodeAllocator
+// (new/delete per node) or PoolNodeAllocator (recycled fixed-size blocks).
+template <typename T, typename Alloc = HeapNodeAllocator>
 class LinkedStack {
 public:
     LinkedStack() noexcept;
@@ -33,30 +37,32 @@ private:
 
     void clear() noexcept;
     static Node* cloneNodes(const Node* node);
+    static Node* makeNode(const T& item, Node* next);
+    static void  freeNode(Node* node) noexcept;
 };
 
 // Template definitions
 
-template <typename T>
-LinkedStack<T>::LinkedStack() noexcept : top_(nullptr) {}
+template <typename T, typename Alloc>
+LinkedStack<T, Alloc>::LinkedStack() noexcept : top_(nullptr) {}
 
-template <typename T>
-LinkedStack<T>::LinkedStack(const LinkedStack& other)
+template <typename T, typename Alloc>
+LinkedStack<T, Alloc>::LinkedStack(const LinkedStack& other)
     : top_(cloneNodes(other.top_)) {}
 
-template <typename T>
-LinkedStack<T>::LinkedStack(LinkedStack&& other) noexcept
+template <typename T, typename Alloc>
+LinkedStack<T, Alloc>::LinkedStack(LinkedStack&& other) noexcept
     : top_(other.top_) {
     other.top_ = nullptr;
 }
 
-template <typename T>
-LinkedStack<T>::~LinkedStack() {
+template <typename T, typename Alloc>
+LinkedStack<T, Alloc>::~LinkedStack() {
     clear();
 }
 
-template <typename T>
-LinkedStack<T>& LinkedStack<T>::operator=(const LinkedStack& other) {
+template <typename T, typename Alloc>
+LinkedStack<T, Alloc>& LinkedStack<T, Alloc>::operator=(const LinkedStack& other) {
     if (this != &other) {
         clear();
         top_ = cloneNodes(other.top_);
@@ -64,8 +70,8 @@ LinkedStack<T>& LinkedStack<T>::operator=(const LinkedStack& other) {
     return *this;
 }
 
-template <typename T>
-LinkedStack<T>& LinkedStack<T>::operator=(LinkedStack&& other) noexcept {
+template <typename T, typename Alloc>
+LinkedStack<T, Alloc>& LinkedStack<T, Alloc>::operator=(LinkedStack&& other) noexcept {
     if (this != &other) {
         clear();
         top_ = other.top_;
@@ -74,36 +80,35 @@ LinkedStack<T>& LinkedStack<T>::operator=(LinkedStack&& other) noexcept {
     return *this;
 }
 
-template <typename T>
-void LinkedStack<T>::push(const T& item) {
-    Node* node = new Node{ item, top_ };
-    top_ = node;
+template <typename T, typename Alloc>
+void LinkedStack<T, Alloc>::push(const T& item) {
+    top_ = makeNode(item, top_);
 }
 
-template <typename T>
-bool LinkedStack<T>::pop(T& out) {
+template <typename T, typename Alloc>
+bool LinkedStack<T, Alloc>::pop(T& out) {
     if (!top_) return false;
     Node* node = top_;
     out = node->data;
     top_ = node->next;
-    delete node;
+    freeNode(node);
     return true;
 }
 
-template <typename T>
-bool LinkedStack<T>::peek(T& out) const {
+template <typename T, typename Alloc>
+bool LinkedStack<T, Alloc>::peek(T& out) const {
     if (!top_) return false;
     out = top_->data;
     return true;
 }
 
-template <typename T>
-bool LinkedStack<T>::isEmpty() const noexcept {
+template <typename T, typename Alloc>
+bool LinkedStack<T, Alloc>::isEmpty() const noexcept {
     return top_ == nullptr;
 }
 
-template <typename T>
-void LinkedStack<T>::print(std::ostream& os) const {
+template <typename T, typename Alloc>
+void LinkedStack<T, Alloc>::print(std::ostream& os) const {
     const Node* current = top_;
     while (current) {
         os << current->data;
@@ -112,9 +117,9 @@ void LinkedStack<T>::print(std::ostream& os) const {
     }
 }
 
-template <typename T>
+template <typename T, typename Alloc>
 template <typename Fn>
-void LinkedStack<T>::forEach(Fn fn) const {
+void LinkedStack<T, Alloc>::forEach(Fn fn) const {
     const Node* current = top_;
     while (current) {
         fn(current->data);
@@ -122,25 +127,54 @@ void LinkedStack<T>::forEach(Fn fn) const {
     }
 }
 
-template <typename T>
-void LinkedStack<T>::clear() noexcept {
+template <typename T, typename Alloc>
+void LinkedStack<T, Alloc>::clear() noexcept {
     while (top_) {
         Node* node = top_;
         top_ = node->next;
-        delete node;
+        freeNode(node);
     }
 }
 
-template <typename T>
-typename LinkedStack<T>::Node* LinkedStack<T>::cloneNodes(const Node* node) {
+template <typename T, typename Alloc>
+typename LinkedStack<T, Alloc>::Node* LinkedStack<T, Alloc>::cloneNodes(const Node* node) {
     if (!node) return nullptr;
-    Node* newTop = new Node{ node->data, nullptr };
+    Node* newTop = makeNode(node->data, nullptr);
     Node* tail = newTop;
     const Node* current = node->next;
-    while (current) {
-        tail->next = new Node{ current->data, nullptr };
-        tail = tail->next;
-        current = current->next;
+    try {
+        while (current) {
+            tail->next = makeNode(current->data, nullptr);
+            tail = tail->next;
+            current = current->next;
+        }
+    }
+    catch (...) {
+        while (newTop) {
+            Node* next = newTop->next;
+            freeNode(newTop);
+            newTop = next;
+        }
+        throw;
     }
     return newTop;
 }
+
+template <typename T, typename Alloc>
+typename LinkedStack<T, Alloc>::Node* LinkedStack<T, Alloc>::makeNode(const T& item, Node* next) {
+    Node* node = Alloc::template allocate<Node>();
+    try {
+        new (node) Node{ item, next };
+    }
+    catch (...) {
+        Alloc::template deallocate<Node>(node);
+        throw;
+    }
+    return node;
+}
+
+template <typename T, typename Alloc>
+void LinkedStack<T, Alloc>::freeNode(Node* node) noexcept {
+    node->~Node();
+    Alloc::template deallocate<Node>(node);
+}
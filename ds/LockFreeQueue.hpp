@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <new>
+#include <thread>
+#include <utility>
+#include "PoolAllocator.hpp"
+
+// Unbounded lock-free multi-producer/multi-consumer FIFO (Michael & Scott).
+// A linked list with a dummy head node: enqueue links a node after the
+// tail with one CAS, dequeue swings head to its successor with another.
+// Threads that find the tail lagging help move it on, so no thread ever
+// waits for another.
+//
+// Nodes are reclaimed with hazard pointers. Before following head or tail a
+// thread publishes the pointer in a hazard slot; a dequeued node is retired
+// rather than freed, and retired nodes are only freed once no slot names
+// them. That also rules out ABA on the head/tail CAS.
+//
+// Hazard slots live in Slots records per queue. An operation borrows a free
+// record for its duration, so any number of threads may use the queue; at
+// most Slots operations run at once and the rest spin until a record frees
+// up. Each record keeps the nodes retired through it and scans all slots
+// once it holds ScanThreshold of them, so reclamation is amortized O(1).
+//
+// Same enqueue/dequeue/isEmpty surface as LinkedQueue. There is no front()
+// or forEach(): another thread may take the element while it is read.
+template <typename T, typename Alloc = HeapNodeAllocator, int Slots = 64>
+class LockFreeQueue {
+public:
+    LockFreeQueue() : records_(new Record[Slots]) {
+        Node* dummy = makeNode();
+        head_.store(dummy, std::memory_order_relaxed);
+        tail_.store(dummy, std::memory_order_relaxed);
+    }
+
+    // No other thread may be using the queue.
+    ~LockFreeQueue() {
+        Node* n = head_.load(std::memory_order_relaxed);
+        Node* next = n->next.load(std::memory_order_relaxed);
+        freeNode(n);
+        while (next) {
+            n = next;
+            next = n->next.load(std::memory_order_relaxed);
+            n->value()->~T();
+            freeNode(n);
+        }
+        for (int i = 0; i < Slots; ++i) {
+            Node* r = records_[i].retired;
+            while (r) {
+                Node* following = r->retiredNext;
+                freeNode(r);
+                r = following;
+            }
+        }
+        delete[] records_;
+    }
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    void enqueue(const T& v) { emplace(v); }
+    void enqueue(T&& v) { emplace(std::move(v)); }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        Node* n = makeNode();
+        try {
+            new (n->value()) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            freeNode(n);
+            throw;
+        }
+
+        Guard g(*this);
+        for (;;) {
+            Node* tail = g.protect(0, tail_);
+            Node* next = tail->next.load(std::memory_order_acquire);
+            if (next) {   // tail is behind; help it along
+                tail_.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+                continue;
+            }
+            Node* expected = nullptr;
+            if (tail->next.compare_exchange_weak(expected, n, std::memory_order_release, std::memory_order_relaxed)) {
+                tail_.compare_exchange_strong(tail, n, std::memory_order_release, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    // Moves the front element into out; false if the queue was empty.
+    bool dequeue(T& out) {
+        Guard g(*this);
+        for (;;) {
+            Node* head = g.protect(0, head_);
+            Node* next = head->next.load(std::memory_order_acquire);
+            g.set(1, next);
+            // While head is still the head its successor cannot have been
+            // retired, so next is now safe to use.
+            if (head != head_.load(std::memory_order_seq_cst)) continue;
+            if (!next) return false;
+
+            Node* tail = tail_.load(std::memory_order_acquire);
+            if (head == tail) {   // tail is behind; help before passing it
+                tail_.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+                continue;
+            }
+            if (head_.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                // next is the new dummy; only the winner touches its value.
+                out = std::move(*next->value());
+                next->value()->~T();
+                g.retire(head);
+                return true;
+            }
+        }
+    }
+
+    // A snapshot: other threads may change it immediately.
+    bool isEmpty() const {
+        Guard g(*this);
+        Node* head = g.protect(0, head_);
+        return head->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    struct Node {
+        std::atomic<Node*> next;
+        Node*              retiredNext;   // separate from next: a lagging
+                                          // enqueuer may still CAS next
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    static const int HazardsPerRecord = 2;
+    static const int ScanThreshold = 2 * HazardsPerRecord * Slots;
+
+    struct alignas(64) Record {
+        std::atomic<bool>  active{ false };
+        std::atomic<Node*> hazard[HazardsPerRecord] = {};
+        Node*              retired = nullptr;   // owned by the current holder
+        int                retiredCount = 0;
+    };
+
+    // Borrows a record for one operation; clears its hazards on the way out.
+    class Guard {
+    public:
+        explicit Guard(const LockFreeQueue& q) : q_(q), rec_(q.acquireRecord()) {}
+        ~Guard() {
+            for (int i = 0; i < HazardsPerRecord; ++i)
+                rec_.hazard[i].store(nullptr, std::memory_order_release);
+            rec_.active.store(false, std::memory_order_release);
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        // Publish src's current value in slot i and return it once src is
+        // confirmed to still hold it.
+        Node* protect(int i, const std::atomic<Node*>& src) {
+            Node* p = src.load(std::memory_order_acquire);
+            for (;;) {
+                rec_.hazard[i].store(p, std::memory_order_seq_cst);
+                Node* again = src.load(std::memory_order_seq_cst);
+                if (again == p) return p;
+                p = again;
+            }
+        }
+
+        void set(int i, Node* p) { rec_.hazard[i].store(p, std::memory_order_seq_cst); }
+
+        void retire(Node* n) {
+            n->retiredNext = rec_.retired;
+            rec_.retired = n;
+            if (++rec_.retiredCount >= ScanThreshold) q_.scan(rec_);
+        }
+
+    private:
+        const LockFreeQueue& q_;
+        Record&              rec_;
+    };
+
+    alignas(64) std::atomic<Node*> head_;
+    alignas(64) std::atomic<Node*> tail_;
+    Record*                        records_;
+
+    Record& acquireRecord() const {
+        static thread_local unsigned hint =
+            static_cast<unsigned>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        for (;;) {
+            for (int k = 0; k < Slots; ++k) {
+                Record& r = records_[(hint + k) % Slots];
+                if (r.active.load(std::memory_order_relaxed)) continue;
+                bool expected = false;
+                if (r.active.compare_exchange_strong(expected, true, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    hint = (hint + k) % Slots;
+                    return r;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    // Free every node retired through rec that no hazard slot names.
+    void scan(Record& rec) const {
+        Node* hazards[HazardsPerRecord * Slots];
+        int count = 0;
+        for (int i = 0; i < Slots; ++i) {
+            for (int h = 0; h < HazardsPerRecord; ++h) {
+                Node* p = records_[i].hazard[h].load(std::memory_order_seq_cst);
+                if (p) hazards[count++] = p;
+            }
+        }
+        std::sort(hazards, hazards + count, std::less<Node*>());
+
+        Node* keep = nullptr;
+        int kept = 0;
+        Node* n = rec.retired;
+        while (n) {
+            Node* following = n->retiredNext;
+            if (std::binary_search(hazards, hazards + count, n, std::less<Node*>())) {
+                n->retiredNext = keep;
+                keep = n;
+                ++kept;
+            }
+            else {
+                freeNode(n);
+            }
+            n = following;
+        }
+        rec.retired = keep;
+        rec.retiredCount = kept;
+    }
+
+    static Node* makeNode() {
+        Node* n = new (Alloc::template allocate<Node>()) Node;
+        n->next.store(nullptr, std::memory_order_relaxed);
+        n->retiredNext = nullptr;
+        return n;
+    }
+
+    // The value must already be destroyed (or never constructed).
+    static void freeNode(Node* n) {
+        n->~Node();
+        Alloc::template deallocate<Node>(n);
+    }
+};
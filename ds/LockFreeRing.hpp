@@ -0,0 +1,210 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// Lock-free bounded rings for passing events between threads (GPS/radio
+// ingestion -> dispatcher). Same enqueue/dequeue surface as CircularQueue;
+// enqueue/dequeue throw like it does, tryEnqueue/tryDequeue never throw and
+// report full/empty through their return value. CAPACITY must be a power
+// of two. Indices that different threads write live on separate cache lines.
+
+constexpr std::size_t RING_CACHE_LINE = 64;
+
+// Single producer, single consumer. One thread may call the enqueue side
+// and one (other) thread the dequeue side, including peekFront.
+template <typename T, std::size_t CAPACITY>
+class SpscRing {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0,
+        "SpscRing capacity must be a power of two");
+
+public:
+    SpscRing() : head(0), tail(0) {}
+
+    ~SpscRing() {
+        T item;
+        while (tryDequeue(item)) {}
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    bool tryEnqueue(const T& item) { return emplace(item); }
+    bool tryEnqueue(T&& item) { return emplace(std::move(item)); }
+
+    bool tryDequeue(T& out) {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        T* slot = slotAt(h);
+        out = std::move(*slot);
+        slot->~T();
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    void enqueue(const T& item) {
+        if (!tryEnqueue(item)) throw std::overflow_error("Queue is full");
+    }
+
+    void enqueue(T&& item) {
+        if (!tryEnqueue(std::move(item))) throw std::overflow_error("Queue is full");
+    }
+
+    T dequeue() {
+        T item;
+        if (!tryDequeue(item)) throw std::underflow_error("Queue is empty");
+        return item;
+    }
+
+    // Consumer side only: the front stays put until this thread dequeues.
+    T& peekFront() {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            throw std::underflow_error("Queue is empty");
+        }
+        return *slotAt(h);
+    }
+
+    // Snapshot only; may be stale as soon as it returns.
+    bool isEmpty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    int getCount() const {
+        return static_cast<int>(tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire));
+    }
+
+private:
+    alignas(RING_CACHE_LINE) std::atomic<std::size_t> head; // consumer-owned
+    alignas(RING_CACHE_LINE) std::atomic<std::size_t> tail; // producer-owned
+    alignas(RING_CACHE_LINE) unsigned char storage[sizeof(T) * CAPACITY];
+
+    T* slotAt(std::size_t i) {
+        return reinterpret_cast<T*>(storage) + (i & (CAPACITY - 1));
+    }
+
+    template <typename U>
+    bool emplace(U&& item) {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == CAPACITY) return false;
+        new (slotAt(t)) T(std::forward<U>(item));
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+// Bounded multi-producer multi-consumer ring (Vyukov). Every cell carries a
+// sequence number that tells producers and consumers whose turn it is, so
+// each operation is one CAS on the shared index plus a release store on the
+// cell. There is no peekFront: with several consumers the front can be
+// taken between the peek and any use of it.
+template <typename T, std::size_t CAPACITY>
+class MpmcRing {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0,
+        "MpmcRing capacity must be a power of two");
+
+public:
+    MpmcRing() : enqueuePos(0), dequeuePos(0) {
+        for (std::size_t i = 0; i < CAPACITY; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpmcRing() {
+        T item;
+        while (tryDequeue(item)) {}
+    }
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    bool tryEnqueue(const T& item) { return emplace(item); }
+    bool tryEnqueue(T&& item) { return emplace(std::move(item)); }
+
+    bool tryDequeue(T& out) {
+        std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & (CAPACITY - 1)];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff =
+                static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) {
+                return false; // empty
+            }
+            else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        T* value = cell->value();
+        out = std::move(*value);
+        value->~T();
+        cell->sequence.store(pos + CAPACITY, std::memory_order_release);
+        return true;
+    }
+
+    void enqueue(const T& item) {
+        if (!tryEnqueue(item)) throw std::overflow_error("Queue is full");
+    }
+
+    void enqueue(T&& item) {
+        if (!tryEnqueue(std::move(item))) throw std::overflow_error("Queue is full");
+    }
+
+    T dequeue() {
+        T item;
+        if (!tryDequeue(item)) throw std::underflow_error("Queue is empty");
+        return item;
+    }
+
+    // Snapshot only; may be stale as soon as it returns.
+    int getCount() const {
+        const std::size_t in = enqueuePos.load(std::memory_order_acquire);
+        const std::size_t out = dequeuePos.load(std::memory_order_acquire);
+        return in > out ? static_cast<int>(in - out) : 0;
+    }
+
+    bool isEmpty() const { return getCount() == 0; }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() { return reinterpret_cast<T*>(storage); }
+    };
+
+    alignas(RING_CACHE_LINE) Cell cells[CAPACITY];
+    alignas(RING_CACHE_LINE) std::atomic<std::size_t> enqueuePos;
+    alignas(RING_CACHE_LINE) std::atomic<std::size_t> dequeuePos;
+
+    template <typename U>
+    bool emplace(U&& item) {
+        std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & (CAPACITY - 1)];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff =
+                static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) {
+                return false; // full
+            }
+            else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        new (cell->value()) T(std::forward<U>(item));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+};
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+// Node allocators for the linked containers (LinkedQueue, LinkedStack).
+// A container asks its Alloc for raw memory for one Node and constructs
+// the node itself:
+//   Node* p = Alloc::template allocate<Node>();
+//   Alloc::template deallocate<Node>(p);
+
+// Plain operator new/delete per node (the original behaviour).
+struct HeapNodeAllocator {
+    template <typename Node>
+    static Node* allocate() { return static_cast<Node*>(::operator new(sizeof(Node))); }
+
+    template <typename Node>
+    static void deallocate(Node* p) { ::operator delete(p); }
+};
+
+// Fixed-size block pool, one per block size. Blocks are carved out of
+// slabs of SlabBlocks at a time and recycled through a free list that
+// belongs to the calling thread, so allocate/deallocate are a couple of
+// pointer moves with no locking and no trip to the general-purpose heap.
+// A block may be freed on a different thread than the one that took it; it
+// joins that thread's list. Once a list holds more than two slabs' worth,
+// all but one slab's worth moves to a shared list in one locked splice,
+// and a thread whose list runs dry drains the shared list before carving a
+// new slab - so a producer/consumer pair keeps recycling the same blocks
+// instead of growing without bound. Free blocks of a thread that exits go
+// to the shared list too. Slabs live until the process ends.
+template <std::size_t Size, std::size_t Align>
+class NodePool {
+public:
+    static const int SlabBlocks = 256;
+
+    static void* take() {
+        Local* local = localList();
+        if (!local) return takeShared();
+        if (!local->free.head) refill(*local);
+        return local->free.pop();
+    }
+
+    static void give(void* p) {
+        Block* b = static_cast<Block*>(p);
+        Local* local = localList();
+        if (!local) {
+            std::lock_guard<std::mutex> guard(shared().lock);
+            shared().orphans.push(b);
+            return;
+        }
+        local->free.push(b);
+        if (local->free.count > 2 * SlabBlocks) spill(*local);
+    }
+
+    // Slabs carved so far by all threads (allocations from the heap).
+    static int slabCount() {
+        std::lock_guard<std::mutex> guard(shared().lock);
+        return shared().slabs;
+    }
+
+private:
+    union Block {
+        Block* next;
+        alignas(Align) unsigned char storage[Size];
+    };
+
+    // Singly linked free list that knows its tail, so whole lists splice
+    // in O(1).
+    struct Chain {
+        Block* head = nullptr;
+        Block* tail = nullptr;
+        int    count = 0;
+
+        void push(Block* b) {
+            b->next = head;
+            head = b;
+            if (!tail) tail = b;
+            ++count;
+        }
+        Block* pop() {
+            Block* b = head;
+            head = b->next;
+            if (!head) tail = nullptr;
+            --count;
+            return b;
+        }
+        // Move every block of other to the front of this list.
+        void prepend(Chain& other) {
+            if (!other.head) return;
+            other.tail->next = head;
+            if (!tail) tail = other.tail;
+            head = other.head;
+            count += other.count;
+            other = Chain();
+        }
+    };
+
+    struct Shared {
+        std::mutex lock;
+        Chain      orphans;   // spilled blocks and those of exited threads
+        int        slabs = 0;
+    };
+
+    struct Local {
+        Chain free;
+        ~Local() {
+            tornDown() = true;
+            std::lock_guard<std::mutex> guard(shared().lock);
+            shared().orphans.prepend(free);
+        }
+    };
+
+    // Leaked on purpose: blocks may still be in use, or sit on a thread's
+    // list, while static objects are destroyed at exit.
+    static Shared& shared() {
+        static Shared* s = new Shared();
+        return *s;
+    }
+
+    // Set once this thread's list is gone. Containers with static storage
+    // release their nodes after that, so they go through the shared list.
+    static bool& tornDown() {
+        thread_local bool gone = false;
+        return gone;
+    }
+
+    static Local* localList() {
+        if (tornDown()) return nullptr;
+        thread_local Local local;
+        return &local;
+    }
+
+    // A fresh slab threaded into a free list.
+    static void carve(Chain& into) {
+        Block* slab = static_cast<Block*>(::operator new(sizeof(Block) * SlabBlocks));
+        for (int i = 0; i < SlabBlocks - 1; ++i) slab[i].next = slab + i + 1;
+        slab[SlabBlocks - 1].next = nullptr;
+        into.head = slab;
+        into.tail = slab + SlabBlocks - 1;
+        into.count = SlabBlocks;
+    }
+
+    static void refill(Local& local) {
+        {
+            std::lock_guard<std::mutex> guard(shared().lock);
+            if (shared().orphans.head) {
+                local.free.prepend(shared().orphans);
+                return;
+            }
+            ++shared().slabs;
+        }
+        carve(local.free);
+    }
+
+    // Keep the SlabBlocks most recently freed blocks, share the rest. Runs
+    // at most once per SlabBlocks frees, so the walk is one step per free.
+    static void spill(Local& local) {
+        Block* keep = local.free.head;
+        for (int i = 1; i < SlabBlocks; ++i) keep = keep->next;
+        Chain surplus;
+        surplus.head = keep->next;
+        surplus.tail = local.free.tail;
+        surplus.count = local.free.count - SlabBlocks;
+        keep->next = nullptr;
+        local.free.tail = keep;
+        local.free.count = SlabBlocks;
+
+        std::lock_guard<std::mutex> guard(shared().lock);
+        shared().orphans.prepend(surplus);
+    }
+
+    static void* takeShared() {
+        std::lock_guard<std::mutex> guard(shared().lock);
+        if (!shared().orphans.head) {
+            carve(shared().orphans);
+            ++shared().slabs;
+        }
+        return shared().orphans.pop();
+    }
+};
+
+// Pool-backed node allocator: every node type gets the NodePool of its size.
+struct PoolNodeAllocator {
+    template <typename Node>
+    static Node* allocate() {
+        return static_cast<Node*>(NodePool<sizeof(Node), alignof(Node)>::take());
+    }
+
+    template <typename Node>
+    static void deallocate(Node* p) {
+        NodePool<sizeof(Node), alignof(Node)>::give(p);
+    }
+};
@@ -1,30 +1,93 @@
 #pragma once
 
+#include <new>
+#include <utility>
+#include "QueueSupport.hpp"
+
 template <typename U>
 struct DefaultGreater {
     bool operator()(const U& a, const U& b) const { return a > b; }
 };
 
-template <typename T, typename Compare = DefaultGreater<T>>
+// Array-backed d-ary max-heap (Arity children per node). Arity 2 is the
+// classic binary heap; 4 halves the depth and keeps a node's children
+// together in memory, which pays off on large queues.
+// Storage is raw memory: only live slots are constructed, growth and pops
+// move elements instead of copying them.
+template <typename T, typename Compare = DefaultGreater<T>, int Arity = 2>
 class PriorityQueue {
+    static_assert(Arity >= 2, "PriorityQueue needs at least two children per node");
+
 public:
     PriorityQueue() : arr_(nullptr), cap_(0), len_(0), cmp_() {
         reserve(8);
     }
-    ~PriorityQueue() { delete[] arr_; }
 
-    void push(const T& v) {
+    // Bulk-build from [first, last): one allocation, O(n) heapify.
+    template <typename It>
+    PriorityQueue(It first, It last) : arr_(nullptr), cap_(0), len_(0), cmp_() {
+        assign(first, last);
+    }
+
+    ~PriorityQueue() {
+        clear();
+        ::operator delete(arr_);
+    }
+
+    PriorityQueue(const PriorityQueue&) = delete;
+    PriorityQueue& operator=(const PriorityQueue&) = delete;
+
+    void push(const T& v) { emplace(v); }
+    void push(T&& v) { emplace(std::move(v)); }
+
+    // Construct the element in place from args.
+    template <typename... Args>
+    void emplace(Args&&... args) {
         if (len_ >= cap_) grow();
-        arr_[len_] = v;
+        new (arr_ + len_) T(std::forward<Args>(args)...);
         siftUp(len_);
         ++len_;
     }
 
+    // Replace the contents with [first, last). Reserves exactly once and
+    // builds the heap bottom-up (Floyd), O(n) instead of n sift-ups.
+    template <typename It>
+    void assign(It first, It last) {
+        clear();
+        pushRange(first, last);
+    }
+
+    // Add every element of [first, last) with a single reservation (see
+    // BatchGrowth). When the batch is at least as large as the current heap,
+    // append it unordered and re-heapify everything in O(n + k); otherwise
+    // sift each new element up, O(k log n).
+    template <typename It>
+    void pushRange(It first, It last) {
+        const int k = BatchGrowth::count(first, last);
+        if (k == 0) return;
+        if (len_ + k > cap_) reserve(BatchGrowth::capacityFor(len_, k, cap_));
+
+        const bool rebuild = k >= len_;
+        for (; first != last; ++first) {
+            new (arr_ + len_) T(*first);
+            if (!rebuild) siftUp(len_);
+            ++len_;
+        }
+        if (rebuild) heapify();
+    }
+
     bool popMax(T& out) {
         if (len_ == 0) return false;
-        out = arr_[0];
-        arr_[0] = arr_[--len_];
-        siftDown(0);
+        out = std::move(arr_[0]);
+        --len_;
+        if (len_ > 0) {
+            arr_[0] = std::move(arr_[len_]);
+            arr_[len_].~T();
+            siftDown(0);
+        }
+        else {
+            arr_[0].~T();
+        }
         return true;
     }
 
@@ -34,57 +97,108 @@ public:
         return true;
     }
 
+    // Best element by reference; the queue must not be empty.
+    const T& top() const { return arr_[0]; }
+
     bool isEmpty() const { return len_ == 0; }
     int  size() const { return len_; }
 
+    void clear() {
+        for (int i = 0; i < len_; ++i) arr_[i].~T();
+        len_ = 0;
+    }
+
+    // Visit every element in heap (array) order. O(n), no allocation.
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (int i = 0; i < len_; ++i) fn(arr_[i]);
+    }
+
+    // Visit elements best-first without touching the heap. A small frontier
+    // heap of array indices is walked instead: visiting k elements costs
+    // O(k log k) and only the frontier (at most k * (Arity - 1) + 1 ints) is
+    // allocated. limit < 0 visits everything.
+    template <typename Fn>
+    void forEachOrdered(Fn fn, int limit = -1) const {
+        if (len_ == 0 || limit == 0) return;
+        const int k = (limit < 0 || limit > len_) ? len_ : limit;
+        const long long bound = static_cast<long long>(k) * (Arity - 1) + 1;
+
+        IndexFrontier frontier(bound < len_ ? static_cast<int>(bound) : len_,
+            [this](int a, int b) { return cmp_(arr_[a], arr_[b]); });
+        frontier.push(0);
+
+        for (int visited = 0; visited < k && !frontier.isEmpty(); ++visited) {
+            const int i = frontier.pop();
+            fn(arr_[i]);
+            const int first = firstChild(i);
+            for (int c = first; c < first + Arity && c < len_; ++c)
+                frontier.push(c);
+        }
+    }
+
 private:
     T* arr_;
     int cap_;
     int len_;
     Compare cmp_;
 
+    // Relocate into a fresh raw block; elements are moved, never copied.
     void reserve(int n) {
         if (n <= cap_) return;
-        T* newArr = new T[n];
-        for (int i = 0; i < len_; ++i) newArr[i] = arr_[i];
-        delete[] arr_;
+        T* newArr = static_cast<T*>(::operator new(sizeof(T) * static_cast<std::size_t>(n)));
+        for (int i = 0; i < len_; ++i) {
+            new (newArr + i) T(std::move(arr_[i]));
+            arr_[i].~T();
+        }
+        ::operator delete(arr_);
         arr_ = newArr;
         cap_ = n;
     }
 
     void grow() { reserve(cap_ == 0 ? 8 : cap_ * 2); }
 
-    static int parent(int i) { return (i - 1) / 2; }
-    static int left(int i) { return 2 * i + 1; }
-    static int right(int i) { return 2 * i + 2; }
+    // Floyd's bottom-up build: sift down every internal node, last first.
+    void heapify() {
+        for (int i = len_ > 1 ? parent(len_ - 1) : -1; i >= 0; --i) siftDown(i);
+    }
+
+    static int parent(int i) { return (i - 1) / Arity; }
+    static int firstChild(int i) { return Arity * i + 1; }
 
+    // Both sifts carry the moving element in a temporary and shift the
+    // others through the hole: one move per level instead of a 3-move swap.
     void siftUp(int i) {
-        while (i > 0) {
-            int p = parent(i);
-            if (cmp_(arr_[i], arr_[p])) {
-                swap(arr_[i], arr_[p]);
-                i = p;
-            }
-            else break;
-        }
+        if (i == 0 || !cmp_(arr_[i], arr_[parent(i)])) return;
+        T moving(std::move(arr_[i]));
+        do {
+            const int p = parent(i);
+            arr_[i] = std::move(arr_[p]);
+            i = p;
+        } while (i > 0 && cmp_(moving, arr_[parent(i)]));
+        arr_[i] = std::move(moving);
     }
 
     void siftDown(int i) {
+        if (bestChild(i) < 0) return;
+        T moving(std::move(arr_[i]));
         while (true) {
-            int l = left(i), r = right(i), largest = i;
-            if (l < len_ && cmp_(arr_[l], arr_[largest])) largest = l;
-            if (r < len_ && cmp_(arr_[r], arr_[largest])) largest = r;
-            if (largest != i) {
-                swap(arr_[i], arr_[largest]);
-                i = largest;
-            }
-            else break;
+            const int c = bestChild(i);
+            if (c < 0 || !cmp_(arr_[c], moving)) break;
+            arr_[i] = std::move(arr_[c]);
+            i = c;
         }
+        arr_[i] = std::move(moving);
     }
 
-    static void swap(T& a, T& b) {
-        T tmp = static_cast<T&&>(a);
-        a = static_cast<T&&>(b);
-        b = static_cast<T&&>(tmp);
+    // Highest-priority child of i, or -1 for a leaf.
+    int bestChild(int i) const {
+        const int first = firstChild(i);
+        if (first >= len_) return -1;
+        const int end = (first + Arity < len_) ? first + Arity : len_;
+        int best = first;
+        for (int c = first + 1; c < end; ++c)
+            if (cmp_(arr_[c], arr_[best])) best = c;
+        return best;
     }
 };
@@ -0,0 +1,69 @@
+#pragma once
+
+// Pieces shared by the priority queues (PriorityQueue, IndexedPriorityQueue,
+// BucketQueue): the capacity policy of pushRange and the frontier heap that
+// forEachOrdered walks.
+
+// Growth for pushRange: count the batch first so storage grows at most once.
+struct BatchGrowth {
+    template <typename It>
+    static int count(It first, It last) {
+        int k = 0;
+        for (; first != last; ++first) ++k;
+        return k;
+    }
+
+    // Capacity to reserve before adding k elements to len of cap. Exact fit
+    // for one big batch, but never less than doubling so a stream of small
+    // batches stays amortised O(1) per element.
+    static int capacityFor(int len, int k, int cap) {
+        return len + k > 2 * cap ? len + k : 2 * cap;
+    }
+};
+
+// Binary heap of int positions ordered by higher(a, b), for visiting a
+// heap best-first without touching it: pop a position, push its children.
+// Holds at most `capacity` positions at once.
+template <typename Higher>
+class IndexFrontier {
+public:
+    IndexFrontier(int capacity, Higher higher) : f_(new int[capacity]), n_(0), higher_(higher) {}
+    ~IndexFrontier() { delete[] f_; }
+
+    IndexFrontier(const IndexFrontier&) = delete;
+    IndexFrontier& operator=(const IndexFrontier&) = delete;
+
+    bool isEmpty() const { return n_ == 0; }
+
+    void push(int idx) {
+        int i = n_++;
+        f_[i] = idx;
+        while (i > 0) {
+            const int p = (i - 1) / 2;
+            if (!higher_(f_[i], f_[p])) break;
+            const int t = f_[i]; f_[i] = f_[p]; f_[p] = t;
+            i = p;
+        }
+    }
+
+    int pop() {
+        const int top = f_[0];
+        f_[0] = f_[--n_];
+        int i = 0;
+        while (true) {
+            const int l = 2 * i + 1, r = 2 * i + 2;
+            int best = i;
+            if (l < n_ && higher_(f_[l], f_[best])) best = l;
+            if (r < n_ && higher_(f_[r], f_[best])) best = r;
+            if (best == i) break;
+            const int t = f_[i]; f_[i] = f_[best]; f_[best] = t;
+            i = best;
+        }
+        return top;
+    }
+
+private:
+    int*   f_;
+    int    n_;
+    Higher higher_;
+};
@@ -0,0 +1,176 @@
+#pragma once
+
+// Uniform grid over a rectangular service area for nearest-neighbour
+// queries on moving points. Points are dense integer ids (unit numbers);
+// each cell threads its points into a doubly linked list through the
+// per-id entries, so insert, move and remove are O(1) and never allocate
+// once the id table is large enough.
+//
+// nearest() searches square rings of cells outward from the query cell and
+// stops as soon as no unvisited cell can hold anything closer, so its cost
+// depends on the local density, not on the number of points.
+// Points outside the area are kept in the nearest edge cell; results stay
+// exact, such points just make their edge cell a little busier.
+class SpatialGrid {
+public:
+    SpatialGrid(double minX, double minY, double maxX, double maxY, double cellSize)
+        : entries_(nullptr), entryCap_(0), heads_(nullptr), cols_(1), rows_(1),
+          minX_(minX), minY_(minY), inv_(1.0 / cellSize), cellSize_(cellSize), len_(0) {
+        while (minX_ + cols_ * cellSize_ < maxX) ++cols_;
+        while (minY_ + rows_ * cellSize_ < maxY) ++rows_;
+        heads_ = new int[cols_ * rows_];
+        for (int i = 0; i < cols_ * rows_; ++i) heads_[i] = -1;
+        reserve(64);
+    }
+    ~SpatialGrid() {
+        delete[] entries_;
+        delete[] heads_;
+    }
+
+    SpatialGrid(const SpatialGrid&) = delete;
+    SpatialGrid& operator=(const SpatialGrid&) = delete;
+
+    // Add point id (>= 0) at (x, y). An id already present is moved instead.
+    void insert(int id, double x, double y) {
+        if (id >= entryCap_) reserve(id + 1 > 2 * entryCap_ ? id + 1 : 2 * entryCap_);
+        if (entries_[id].cell >= 0) {
+            move(id, x, y);
+            return;
+        }
+        entries_[id].x = x;
+        entries_[id].y = y;
+        link(id, cellOf(x, y));
+        ++len_;
+    }
+
+    // New position for a present id; only relinks when the cell changes.
+    bool move(int id, double x, double y) {
+        if (!contains(id)) return false;
+        Entry& e = entries_[id];
+        e.x = x;
+        e.y = y;
+        const int cell = cellOf(x, y);
+        if (cell != e.cell) {
+            unlink(id);
+            link(id, cell);
+        }
+        return true;
+    }
+
+    bool remove(int id) {
+        if (!contains(id)) return false;
+        unlink(id);
+        entries_[id].cell = -1;
+        --len_;
+        return true;
+    }
+
+    bool contains(int id) const { return id >= 0 && id < entryCap_ && entries_[id].cell >= 0; }
+    int  size() const { return len_; }
+    bool isEmpty() const { return len_ == 0; }
+
+    // Id of the point closest to (x, y), -1 if the grid is empty.
+    // distSq (optional) receives the squared distance.
+    int nearest(double x, double y, double* distSq = nullptr) const {
+        if (len_ == 0) return -1;
+        const int qc = colOf(x);
+        const int qr = rowOf(y);
+        int    best = -1;
+        double bestD = 0.0;
+
+        for (int r = 0; ; ++r) {
+            const int c0 = qc - r, c1 = qc + r, r0 = qr - r, r1 = qr + r;
+            for (int row = r0; row <= r1; ++row) {
+                if (row < 0 || row >= rows_) continue;
+                const bool edgeRow = (row == r0 || row == r1);
+                for (int col = c0; col <= c1; col += (edgeRow ? 1 : c1 - c0)) {
+                    if (col >= 0 && col < cols_) scanCell(row * cols_ + col, x, y, best, bestD);
+                    if (c1 == c0) break;
+                }
+            }
+
+            // Everything not yet visited lies outside the square of cells
+            // [c0, c1] x [r0, r1]; sides on the area's border have nothing
+            // beyond them (outside points live in the edge cells).
+            const double inf = 1e300;
+            double bound = inf;
+            if (c0 > 0)         bound = min(bound, x - (minX_ + c0 * cellSize_));
+            if (c1 < cols_ - 1) bound = min(bound, minX_ + (c1 + 1) * cellSize_ - x);
+            if (r0 > 0)         bound = min(bound, y - (minY_ + r0 * cellSize_));
+            if (r1 < rows_ - 1) bound = min(bound, minY_ + (r1 + 1) * cellSize_ - y);
+            if (bound == inf) break;                      // whole area searched
+            if (best >= 0 && bound > 0 && bestD <= bound * bound) break;
+        }
+        if (distSq) *distSq = bestD;
+        return best;
+    }
+
+private:
+    struct Entry {
+        double x = 0.0;
+        double y = 0.0;
+        int    cell = -1;   // -1 while the id is not in the grid
+        int    next = -1;
+        int    prev = -1;
+    };
+
+    Entry* entries_;
+    int    entryCap_;
+    int*   heads_;
+    int    cols_;
+    int    rows_;
+    double minX_;
+    double minY_;
+    double inv_;
+    double cellSize_;
+    int    len_;
+
+    static double min(double a, double b) { return a < b ? a : b; }
+
+    void reserve(int n) {
+        if (n <= entryCap_) return;
+        Entry* fresh = new Entry[n];
+        for (int i = 0; i < entryCap_; ++i) fresh[i] = entries_[i];
+        delete[] entries_;
+        entries_ = fresh;
+        entryCap_ = n;
+    }
+
+    int colOf(double x) const {
+        const double c = (x - minX_) * inv_;
+        return c < 0 ? 0 : (c >= cols_ ? cols_ - 1 : static_cast<int>(c));
+    }
+    int rowOf(double y) const {
+        const double r = (y - minY_) * inv_;
+        return r < 0 ? 0 : (r >= rows_ ? rows_ - 1 : static_cast<int>(r));
+    }
+    int cellOf(double x, double y) const { return rowOf(y) * cols_ + colOf(x); }
+
+    void link(int id, int cell) {
+        Entry& e = entries_[id];
+        e.cell = cell;
+        e.prev = -1;
+        e.next = heads_[cell];
+        if (e.next >= 0) entries_[e.next].prev = id;
+        heads_[cell] = id;
+    }
+
+    void unlink(int id) {
+        Entry& e = entries_[id];
+        if (e.prev >= 0) entries_[e.prev].next = e.next;
+        else heads_[e.cell] = e.next;
+        if (e.next >= 0) entries_[e.next].prev = e.prev;
+    }
+
+    void scanCell(int cell, double x, double y, int& best, double& bestD) const {
+        for (int id = heads_[cell]; id >= 0; id = entries_[id].next) {
+            const double dx = entries_[id].x - x;
+            const double dy = entries_[id].y - y;
+            const double d = dx * dx + dy * dy;
+            if (best < 0 || d < bestD) {
+                best = id;
+                bestD = d;
+            }
+        }
+    }
+};
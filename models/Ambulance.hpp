@@ -1,14 +1,56 @@
 #pragma once
 #include <string>
-#include <ostream>   
+#include <ostream>
+
+enum class AmbulanceStatus {
+    Available,
+    EnRoute,
+    AtScene,
+    OutOfService
+};
+
+constexpr int AMBULANCE_STATUS_COUNT = 4;
+
+// Allowed status changes:
+//   Available      -> En route, Out of service
+//   En route       -> At scene, Available (recalled)
+//   At scene       -> Available, Out of service
+//   Out of service -> Available
+inline bool canTransition(AmbulanceStatus from, AmbulanceStatus to) {
+    switch (from) {
+    case AmbulanceStatus::Available:
+        return to == AmbulanceStatus::EnRoute || to == AmbulanceStatus::OutOfService;
+    case AmbulanceStatus::EnRoute:
+        return to == AmbulanceStatus::AtScene || to == AmbulanceStatus::Available;
+    case AmbulanceStatus::AtScene:
+        return to == AmbulanceStatus::Available || to == AmbulanceStatus::OutOfService;
+    case AmbulanceStatus::OutOfService:
+        return to == AmbulanceStatus::Available;
+    }
+    return false;
+}
+
+inline const char* toString(AmbulanceStatus s) {
+    switch (s) {
+    case AmbulanceStatus::Available:    return "Available";
+    case AmbulanceStatus::EnRoute:      return "En route";
+    case AmbulanceStatus::AtScene:      return "At scene";
+    case AmbulanceStatus::OutOfService: return "Out of service";
+    }
+    return "?";
+}
 
 struct Ambulance {
     std::string code;
     std::string driverName;
+    double x = 0.0;   // last reported position, km east of the map origin
+    double y = 0.0;   // km north of the map origin
+    AmbulanceStatus status = AmbulanceStatus::Available;
 };
 
 // Used by CircularQueue::display for nice printing
 inline std::ostream& operator<<(std::ostream& os, const Ambulance& ambulance) {
-    os << ambulance.code << " - Driver: " << ambulance.driverName;
+    os << ambulance.code << " - Driver: " << ambulance.driverName
+        << " [" << toString(ambulance.status) << "]";
     return os;
 }
@@ -4,4 +4,5 @@ struct EmergencyCase {
     std::string name;
     std::string type;
     int         priority{};
+    long long   arrivalTime{};   // seconds on the module clock; 0 = stamp on logging
 };
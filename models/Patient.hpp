@@ -1,7 +1,92 @@
 #pragma once
+#include <cstdint>
 #include <string>
+#include "../ds/DynamicArray.hpp"
+#include "../ds/HashIndex.hpp"
+
+// Patient as entered at the desk or read from a file.
 struct Patient {
     std::string id;
     std::string name;
     std::string conditionType;
 };
+
+// "P###" <-> number. Accepts 'P' followed by 1 to 9 digits; leading zeros
+// are not significant, so "P007" and "P7" are the same patient. Formatting
+// pads to at least three digits.
+inline bool parsePatientId(const std::string& text, std::uint32_t& id) {
+    if (text.size() < 2 || text.size() > 10 || text[0] != 'P') return false;
+    std::uint32_t value = 0;
+    for (std::size_t i = 1; i < text.size(); ++i) {
+        if (text[i] < '0' || text[i] > '9') return false;
+        value = value * 10 + static_cast<std::uint32_t>(text[i] - '0');
+    }
+    id = value;
+    return true;
+}
+
+inline std::string formatPatientId(std::uint32_t id) {
+    std::string digits = std::to_string(id);
+    if (digits.size() < 3) digits.insert(0, 3 - digits.size(), '0');
+    return "P" + digits;
+}
+
+// Process-wide table of condition names. Each distinct spelling is stored
+// once and referred to by a 16-bit code; codes are never reused, so a
+// name reference stays valid for the life of the program. Not
+// thread-safe: intern from one thread (the desk / loader).
+class ConditionTable {
+public:
+    static const int MaxCodes = 65536;
+
+    // Code for the name, adding it if new. False if the table is full.
+    static bool intern(const std::string& name, std::uint16_t& code) {
+        Table& t = table();
+        if (const std::uint16_t* known = t.codes.find(name)) {
+            code = *known;
+            return true;
+        }
+        if (t.names.size() == MaxCodes) return false;
+        code = static_cast<std::uint16_t>(t.names.size());
+        t.names.push(new std::string(name));
+        t.codes.insert(name, code);
+        return true;
+    }
+
+    static const std::string& name(std::uint16_t code) { return *table().names[code]; }
+
+    static int size() { return table().names.size(); }
+
+private:
+    struct Table {
+        DynamicArray<std::string*>                names;
+        HashIndex<std::string, std::uint16_t>     codes;
+    };
+
+    // Leaked on purpose so names outlive every static that refers to them.
+    static Table& table() {
+        static Table* t = new Table();
+        return *t;
+    }
+};
+
+// Compact form the patient queue stores: 40 bytes on a 64-bit build
+// (vs. 96 for Patient), and short names fit the string's inline buffer,
+// so a record usually needs no heap allocation of its own.
+struct PatientRecord {
+    std::uint32_t id = 0;          // number part of "P###"
+    std::uint16_t condition = 0;   // ConditionTable code
+    std::string   name;
+};
+
+// Fails on a malformed ID or a full condition table.
+inline bool toRecord(const Patient& p, PatientRecord& out) {
+    if (!parsePatientId(p.id, out.id)) return false;
+    if (!ConditionTable::intern(p.conditionType, out.condition)) return false;
+    out.name = p.name;
+    return true;
+}
+
+inline Patient toPatient(const PatientRecord& r) {
+    return Patient{ formatPatientId(r.id), r.name, ConditionTable::name(r.condition) };
+}
@@ -1,7 +1,75 @@
 #pragma once
+#include <chrono>
 #include <string>
+
+// Expiry dates are whole days since 1970-01-01 (UTC).
+constexpr int SUPPLY_NO_EXPIRY = 2147483647;   // non-perishable
+
 struct SupplyItem {
     std::string type;
     int         quantity{};
     std::string batch;
+    int         expiryDay = SUPPLY_NO_EXPIRY;
 };
+
+// Proleptic Gregorian calendar <-> day number (H. Hinnant's algorithms).
+inline int daysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const int yoe = y - era * 400;
+    const int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+inline void civilFromDays(int z, int& y, int& m, int& d) {
+    z += 719468;
+    const int era = (z >= 0 ? z : z - 146096) / 146097;
+    const int doe = z - era * 146097;
+    const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const int mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp + (mp < 10 ? 3 : -9);
+    y = yoe + era * 400 + (m <= 2);
+}
+
+// "YYYY-MM-DD" -> day number; false if malformed or not a real date.
+inline bool parseDate(const std::string& text, int& day) {
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-') return false;
+    int parts[3] = { 0, 0, 0 };
+    const int starts[3] = { 0, 5, 8 };
+    const int lengths[3] = { 4, 2, 2 };
+    for (int p = 0; p < 3; ++p) {
+        for (int i = starts[p]; i < starts[p] + lengths[p]; ++i) {
+            if (text[i] < '0' || text[i] > '9') return false;
+            parts[p] = parts[p] * 10 + (text[i] - '0');
+        }
+    }
+    if (parts[1] < 1 || parts[1] > 12 || parts[2] < 1 || parts[2] > 31) return false;
+    const int candidate = daysFromCivil(parts[0], parts[1], parts[2]);
+    int y, m, d;
+    civilFromDays(candidate, y, m, d);
+    if (m != parts[1] || d != parts[2]) return false;   // e.g. 2025-02-30
+    day = candidate;
+    return true;
+}
+
+// Day number -> "YYYY-MM-DD", or "-" for SUPPLY_NO_EXPIRY.
+inline std::string formatDate(int day) {
+    if (day == SUPPLY_NO_EXPIRY) return "-";
+    int y, m, d;
+    civilFromDays(day, y, m, d);
+    std::string out = std::to_string(y);
+    out += m < 10 ? "-0" : "-";
+    out += std::to_string(m);
+    out += d < 10 ? "-0" : "-";
+    out += std::to_string(d);
+    return out;
+}
+
+inline int todayDay() {
+    using namespace std::chrono;
+    const long long secs = duration_cast<seconds>(system_clock::now().time_since_epoch()).count();
+    return static_cast<int>(secs >= 0 ? secs / 86400 : (secs - 86399) / 86400);
+}
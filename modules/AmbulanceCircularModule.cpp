@@ -1,16 +1,62 @@
 #include "AmbulanceCircularModule.hpp"
 #include <iostream>
 
-AmbulanceCircularModule::AmbulanceCircularModule() : queue() {}
+AmbulanceCircularModule::AmbulanceCircularModule()
+    : queue(), slotByCode(), dispatch(), available(queue.getCapacity()) {
+    for (int i = 0; i < AMBULANCE_STATUS_COUNT; ++i) statusCounts[i] = 0;
+}
+
+void AmbulanceCircularModule::reindex() {
+    slotByCode.clear();
+    available.resize(queue.getCapacity());
+    for (int i = 0; i < queue.getCount(); ++i) {
+        const int s = queue.slotOf(i);
+        slotByCode.insert(queue.at(i).code, s);
+        if (queue.at(i).status == AmbulanceStatus::Available) available.set(s);
+    }
+}
+
+// Called by the ring for every unit it moves. The old slot is cleared before
+// anything can move into it, so chained moves keep the bitmap exact.
+void AmbulanceCircularModule::unitMoved(const Ambulance& a, int newSlot) {
+    int& s = *slotByCode.find(a.code);
+    available.reset(s);
+    s = newSlot;
+    if (a.status == AmbulanceStatus::Available) available.set(newSlot);
+}
+
+void AmbulanceCircularModule::applyStatus(int slot, AmbulanceStatus status) {
+    Ambulance& a = queue.atSlot(slot);
+    --statusCounts[static_cast<int>(a.status)];
+    ++statusCounts[static_cast<int>(status)];
+    a.status = status;
+    available.assign(slot, status == AmbulanceStatus::Available);
+    dispatch.setStatus(a.code, status);
+}
 
 bool AmbulanceCircularModule::registerAmbulance(const Ambulance& a) {
+    if (slotByCode.contains(a.code)) {
+        std::cout << "[Error] Ambulance " << a.code
+            << " is already registered.\n";
+        return false;
+    }
     if (queue.isFull()) {
         std::cout << "[Error] Ambulance queue is full. Cannot register "
             << a.code << ".\n";
         return false;
     }
 
+    const int capacity = queue.getCapacity();
     queue.enqueue(a);
+    if (queue.getCapacity() != capacity) reindex();
+    else {
+        const int s = queue.slotOf(queue.getCount() - 1);
+        slotByCode.insert(a.code, s);
+        available.assign(s, a.status == AmbulanceStatus::Available);
+    }
+    ++statusCounts[static_cast<int>(a.status)];
+    dispatch.addUnit(a);
+
     std::cout << "[Ambulance Registered] " << a.code
         << " - Driver: " << a.driverName << "\n";
     return true;
@@ -22,11 +68,139 @@ bool AmbulanceCircularModule::rotateOnce() {
         return false;
     }
 
-    queue.rotateOnce();
+    rotateQueue(1);
     std::cout << "[Shift rotation done successfully]\n";
     return true;
 }
 
+bool AmbulanceCircularModule::advanceRotation(int k) {
+    if (queue.isEmpty()) {
+        std::cout << "[Info] No ambulances to rotate.\n";
+        return false;
+    }
+
+    rotateQueue(k);
+    std::cout << "[Rotation advanced by " << k << "] Next unit: "
+        << queue.peekFront().code << "\n";
+    return true;
+}
+
+bool AmbulanceCircularModule::rotateTo(const std::string& code) {
+    const int pos = positionOf(code);
+    if (pos < 0) {
+        std::cout << "[Error] No ambulance with code " << code << ".\n";
+        return false;
+    }
+    rotateQueue(pos);
+    std::cout << "[Rotation] " << code << " is now at the front\n";
+    return true;
+}
+
+const Ambulance* AmbulanceCircularModule::findByCode(const std::string& code) const {
+    const int* s = slotByCode.find(code);
+    return s ? &queue.atSlot(*s) : nullptr;
+}
+
+int AmbulanceCircularModule::positionOf(const std::string& code) const {
+    const int* s = slotByCode.find(code);
+    return s ? queue.positionOfSlot(*s) : -1;
+}
+
+bool AmbulanceCircularModule::removeAmbulance(const std::string& code, Ambulance& out) {
+    const int pos = positionOf(code);
+    if (pos < 0) {
+        std::cout << "[Error] No ambulance with code " << code << ".\n";
+        return false;
+    }
+    available.reset(queue.slotOf(pos));
+    out = queue.removeAt(pos, [this](const Ambulance& moved, int s) { unitMoved(moved, s); });
+    slotByCode.erase(code);
+    --statusCounts[static_cast<int>(out.status)];
+    dispatch.removeUnit(code);
+    std::cout << "[Ambulance Removed] " << out.code << " left the rotation\n";
+    return true;
+}
+
+bool AmbulanceCircularModule::updatePosition(const std::string& code, double x, double y) {
+    const int* s = slotByCode.find(code);
+    if (!s) {
+        std::cout << "[Error] No ambulance with code " << code << ".\n";
+        return false;
+    }
+    Ambulance& a = queue.atSlot(*s);
+    a.x = x;
+    a.y = y;
+    dispatch.updatePosition(code, x, y);
+    return true;
+}
+
+bool AmbulanceCircularModule::setStatus(const std::string& code, AmbulanceStatus status) {
+    const int* s = slotByCode.find(code);
+    if (!s) {
+        std::cout << "[Error] No ambulance with code " << code << ".\n";
+        return false;
+    }
+    const AmbulanceStatus from = queue.atSlot(*s).status;
+    if (!canTransition(from, status)) {
+        std::cout << "[Error] " << code << " cannot go from " << toString(from)
+            << " to " << toString(status) << ".\n";
+        return false;
+    }
+    applyStatus(*s, status);
+    std::cout << "[Status] " << code << " is now " << toString(status) << "\n";
+    return true;
+}
+
+bool AmbulanceCircularModule::nextAvailable(Ambulance& out) const {
+    if (queue.isEmpty()) return false;
+    const int s = available.findNext(queue.slotOf(0));
+    if (s < 0) return false;
+    out = queue.atSlot(s);
+    return true;
+}
+
+bool AmbulanceCircularModule::dispatchNextInRotation(Ambulance& out) {
+    const int s = queue.isEmpty() ? -1 : available.findNext(queue.slotOf(0));
+    if (s < 0) {
+        std::cout << "[Info] No ambulance is available.\n";
+        return false;
+    }
+    applyStatus(s, AmbulanceStatus::EnRoute);
+    out = queue.atSlot(s);
+    rotateQueue(queue.positionOfSlot(s) + 1);
+    std::cout << "[Dispatched] " << out.code << " (" << out.driverName
+        << "), next in rotation: " << queue.peekFront().code << "\n";
+    return true;
+}
+
+int AmbulanceCircularModule::countByStatus(AmbulanceStatus status) const {
+    return statusCounts[static_cast<int>(status)];
+}
+
+void AmbulanceCircularModule::printStatusSummary(std::ostream& os) const {
+    os << "--- Fleet Status ---\n";
+    for (int i = 0; i < AMBULANCE_STATUS_COUNT; ++i) {
+        os << toString(static_cast<AmbulanceStatus>(i)) << ": " << statusCounts[i] << "\n";
+    }
+    os << "Total: " << queue.getCount() << "\n";
+}
+
+bool AmbulanceCircularModule::dispatchNearest(double x, double y, Ambulance& out) {
+    if (!dispatch.nearestAvailable(x, y, out)) {
+        std::cout << "[Info] No ambulance is available.\n";
+        return false;
+    }
+    applyStatus(*slotByCode.find(out.code), AmbulanceStatus::EnRoute);
+    out.status = AmbulanceStatus::EnRoute;
+    std::cout << "[Dispatched] " << out.code << " (" << out.driverName
+        << ") from " << out.x << "," << out.y << "\n";
+    return true;
+}
+
+void AmbulanceCircularModule::rotateQueue(int k) {
+    queue.rotate(k, [this](const Ambulance& moved, int s) { unitMoved(moved, s); });
+}
+
 void AmbulanceCircularModule::printRotation(std::ostream& os) const {
     queue.display(os);
 }
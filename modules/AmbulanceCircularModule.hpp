@@ -1,24 +1,87 @@
 #pragma once
 
 #include <iosfwd>
+#include <string>
 #include "../models/Ambulance.hpp"
 #include "../ds/CircularQueue.hpp"
+#include "../ds/HashIndex.hpp"
+#include "../ds/Bitmap.hpp"
+#include "DispatchEngine.hpp"
 
 // Module that manages ambulances using a circular queue
 class AmbulanceCircularModule {
 private:
-    // Fixed-size circular queue with capacity 10
-    CircularQueue<Ambulance, 10> queue;
+    // Growable circular queue; the fleet is no longer capped at 10
+    CircularQueue<Ambulance, CIRCULAR_GROWABLE> queue;
+
+    // code -> physical ring slot. Slots survive full-ring rotations; the
+    // ring reports every element it moves otherwise, and a growth rebuilds
+    // the index (amortised O(1) like the growth itself).
+    HashIndex<std::string, int> slotByCode;
+
+    // Same fleet, indexed by position for nearest-available dispatch.
+    DispatchEngine dispatch;
+
+    // Bit s set <=> ring slot s holds an Available unit. Kept in step with
+    // slotByCode, so the next available unit in rotation order is one
+    // find-next-set from the front slot.
+    Bitmap available;
+    int    statusCounts[AMBULANCE_STATUS_COUNT];
+
+    void reindex();
+    void rotateQueue(int k);   // queue.rotate, keeping the slot indexes in sync
+    void unitMoved(const Ambulance& a, int newSlot);
+    void applyStatus(int slot, AmbulanceStatus status);
 
 public:
     AmbulanceCircularModule();
 
-    // Register a new ambulance. Returns false if the queue is full.
+    // Register a new ambulance. Returns false if the code is already
+    // registered or the queue is full (only possible with a fixed-size queue).
     bool registerAmbulance(const Ambulance& a);
 
+    // O(1) lookup by code; nullptr if no such unit is registered.
+    const Ambulance* findByCode(const std::string& code) const;
+
+    // Place of the unit in the rotation (0 = front), -1 if unknown. O(1).
+    int positionOf(const std::string& code) const;
+
+    // Take a unit out of the rotation. Returns false if no such unit.
+    bool removeAmbulance(const std::string& code, Ambulance& out);
+
+    // Position report for a unit (km on the service map). O(1).
+    bool updatePosition(const std::string& code, double x, double y);
+
+    // Change a unit's status; only the moves allowed by canTransition()
+    // are accepted. O(1).
+    bool setStatus(const std::string& code, AmbulanceStatus status);
+
+    // First Available unit in rotation order, without changing anything.
+    bool nextAvailable(Ambulance& out) const;
+
+    // Send the first Available unit in rotation order (it becomes EnRoute)
+    // and move the rotation on to the unit after it.
+    bool dispatchNextInRotation(Ambulance& out);
+
+    // Units per status, kept up to date on every change. O(1).
+    int  countByStatus(AmbulanceStatus status) const;
+    void printStatusSummary(std::ostream& os) const;
+
+    // Send the closest Available unit to (x, y); it becomes EnRoute.
+    // Returns false if no unit is available.
+    bool dispatchNearest(double x, double y, Ambulance& out);
+
     // Rotate the shift order by one. Returns false if queue is empty.
     bool rotateOnce();
 
+    // Advance the shift order by k units in one step. Returns false if
+    // queue is empty.
+    bool advanceRotation(int k);
+
+    // Rotate until the unit with this code is at the front. Returns false
+    // if no such unit is registered. O(1) lookup, then one rotate().
+    bool rotateTo(const std::string& code);
+
     // Print current rotation order to the given stream.
     void printRotation(std::ostream& os) const;
 
@@ -0,0 +1,86 @@
+#include "DispatchEngine.hpp"
+
+DispatchEngine::DispatchEngine(double width, double height, double cellSize)
+    : units_(), freeIds_(), idByCode_(), available_(0.0, 0.0, width, height, cellSize) {}
+
+bool DispatchEngine::addUnit(const Ambulance& a) {
+    if (a.code.empty() || idByCode_.contains(a.code)) return false;
+
+    int id;
+    if (!freeIds_.isEmpty()) {
+        id = freeIds_.back();
+        freeIds_.pop();
+        units_[id] = a;
+    }
+    else {
+        id = units_.size();
+        units_.push(a);
+    }
+    idByCode_.insert(a.code, id);
+    if (a.status == AmbulanceStatus::Available) available_.insert(id, a.x, a.y);
+    return true;
+}
+
+bool DispatchEngine::removeUnit(const std::string& code) {
+    const int id = unitId(code);
+    if (id < 0) return false;
+    available_.remove(id);
+    idByCode_.erase(code);
+    units_[id] = Ambulance();
+    freeIds_.push(id);
+    return true;
+}
+
+int DispatchEngine::unitId(const std::string& code) const {
+    const int* id = idByCode_.find(code);
+    return id ? *id : -1;
+}
+
+const Ambulance* DispatchEngine::findByCode(const std::string& code) const {
+    return unit(unitId(code));
+}
+
+const Ambulance* DispatchEngine::unit(int id) const {
+    if (id < 0 || id >= units_.size() || units_[id].code.empty()) return nullptr;
+    return &units_[id];
+}
+
+bool DispatchEngine::updatePosition(const std::string& code, double x, double y) {
+    return updatePosition(unitId(code), x, y);
+}
+
+bool DispatchEngine::updatePosition(int id, double x, double y) {
+    if (!unit(id)) return false;
+    units_[id].x = x;
+    units_[id].y = y;
+    available_.move(id, x, y);   // no-op unless the unit is Available
+    return true;
+}
+
+bool DispatchEngine::setStatus(const std::string& code, AmbulanceStatus status) {
+    return setStatus(unitId(code), status);
+}
+
+bool DispatchEngine::setStatus(int id, AmbulanceStatus status) {
+    if (!unit(id)) return false;
+    Ambulance& a = units_[id];
+    a.status = status;
+    if (status == AmbulanceStatus::Available) available_.insert(id, a.x, a.y);
+    else available_.remove(id);
+    return true;
+}
+
+bool DispatchEngine::nearestAvailable(double x, double y, Ambulance& out) const {
+    const int id = available_.nearest(x, y);
+    if (id < 0) return false;
+    out = units_[id];
+    return true;
+}
+
+bool DispatchEngine::dispatchNearest(double x, double y, Ambulance& out) {
+    const int id = available_.nearest(x, y);
+    if (id < 0) return false;
+    setStatus(id, AmbulanceStatus::EnRoute);
+    out = units_[id];
+    return true;
+}
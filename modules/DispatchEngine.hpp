@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include "../models/Ambulance.hpp"
+#include "../ds/DynamicArray.hpp"
+#include "../ds/HashIndex.hpp"
+#include "../ds/SpatialGrid.hpp"
+
+// Answers "which available unit is closest to this incident?".
+// Every unit gets a dense id on registration (recycled on removal); only
+// Available units sit in the spatial grid, so a nearest query never wades
+// through busy ones and a status change is a single grid insert/remove.
+class DispatchEngine {
+public:
+    // Service area in km from the map origin, split into cellSize cells.
+    // Positions outside the area still work (see SpatialGrid).
+    explicit DispatchEngine(double width = 100.0, double height = 100.0, double cellSize = 1.0);
+
+    bool addUnit(const Ambulance& a);               // false if the code is taken
+    bool removeUnit(const std::string& code);
+
+    int  unitId(const std::string& code) const;     // -1 if unknown
+    const Ambulance* findByCode(const std::string& code) const;
+    const Ambulance* unit(int id) const;            // nullptr if the id is free
+
+    // Position report. O(1): the unit is relinked only when it changes cell.
+    // The id overload skips the code lookup for high-rate GPS feeds.
+    bool updatePosition(const std::string& code, double x, double y);
+    bool updatePosition(int id, double x, double y);
+
+    bool setStatus(const std::string& code, AmbulanceStatus status);
+    bool setStatus(int id, AmbulanceStatus status);
+
+    // Closest Available unit to (x, y), nothing changes. False if none.
+    bool nearestAvailable(double x, double y, Ambulance& out) const;
+
+    // Closest Available unit, which is marked EnRoute. False if none.
+    bool dispatchNearest(double x, double y, Ambulance& out);
+
+    int getUnitCount() const { return idByCode_.size(); }
+    int getAvailableCount() const { return available_.size(); }
+
+private:
+    DynamicArray<Ambulance>     units_;     // by id; empty code marks a free id
+    DynamicArray<int>           freeIds_;
+    HashIndex<std::string, int> idByCode_;
+    SpatialGrid                 available_; // Available units only
+};
@@ -1,81 +1,206 @@
 #include "modules/EmergencyPQModule.hpp"
-#include "ds/PriorityQueue.hpp"
 #include <iostream>
 #include <iomanip>
+#include <iterator>
+#include <utility>
 
-// comparator  higher priority first, break ties alphabetically
-struct EmergencyHigher {
-    bool operator()(const EmergencyCase& a, const EmergencyCase& b) const {
-        if (a.priority != b.priority)
-            return a.priority > b.priority;
-        return a.name < b.name;
-    }
-};
+template <typename Queue>
+BasicEmergencyPQModule<Queue>::BasicEmergencyPQModule() : nextTicket_(1) {}
+
+template <typename Queue>
+int BasicEmergencyPQModule<Queue>::track(int handle) {
+    while (pending_.size() <= handle) pending_.push(Pending{ -1, 0, 0 });
+    const int ticket = nextTicket_++;
+    pending_[handle].ticket = ticket;
+    pending_[handle].triage = pq_.get(handle)->priority;
+    handleOfTicket_.insert(ticket, handle);
+    return ticket;
+}
+
+template <typename Queue>
+void BasicEmergencyPQModule<Queue>::untrack(int handle) {
+    handleOfTicket_.erase(pending_[handle].ticket);
+    pending_[handle].ticket = -1;
+}
+
+template <typename Queue>
+int BasicEmergencyPQModule<Queue>::handleOf(int ticket) const {
+    const int* handle = handleOfTicket_.find(ticket);
+    return handle ? *handle : -1;
+}
+
+template <typename Queue>
+void BasicEmergencyPQModule<Queue>::countIn(int priority) {
+    ++stats_.total;
+    ++stats_.counts[priority];
+    if (priority > stats_.maxPriority) stats_.maxPriority = priority;
+}
+
+template <typename Queue>
+void BasicEmergencyPQModule<Queue>::countOut(int priority) {
+    --stats_.total;
+    --stats_.counts[priority];
+    // Only five levels, so finding the new maximum is constant time.
+    while (stats_.maxPriority > 0 && stats_.counts[stats_.maxPriority] == 0)
+        --stats_.maxPriority;
+}
+
+template <typename Queue>
+void BasicEmergencyPQModule<Queue>::recordWait(const EmergencyCase& c, int triage) {
+    static const long long edges[5] = { 60, 300, 900, 1800, 3600 };
+    const long long waited = clock_() - c.arrivalTime;
+
+    int bucket = 0;
+    while (bucket < 5 && waited >= edges[bucket]) ++bucket;
+    ++stats_.waitHistogram[bucket];
+    ++stats_.processed;
+    if (waited > aging_.slaSeconds[triage]) ++stats_.slaBreaches;
+}
+
+template <typename Queue>
+void BasicEmergencyPQModule<Queue>::scheduleAging(int handle, const EmergencyCase& c, long long from) {
+    // Whatever was scheduled for this case before is stale from here on,
+    // even if no new promotion is due.
+    Pending& p = pending_[handle];
+    ++p.generation;
+    if (aging_.stepSeconds <= 0 || c.priority >= 5) return;
+    agingDue_.push(AgingEntry{ from + aging_.stepSeconds, p.ticket, p.generation });
+}
 
+// One bottom-up heap build for the whole batch; the handles it reports are
+// then walked to issue tickets and schedule aging.
+template <typename Queue>
+void BasicEmergencyPQModule<Queue>::insertBatch(DynamicArray<EmergencyCase>& batch) {
+    DynamicArray<int> handles;
+    handles.reserve(batch.size());
+    for (int i = 0; i < batch.size(); ++i) handles.push(-1);
+    pq_.pushRange(std::make_move_iterator(batch.data()),
+        std::make_move_iterator(batch.data() + batch.size()), handles.data());
 
-static PriorityQueue<EmergencyCase, EmergencyHigher> g_pq;
+    for (int i = 0; i < handles.size(); ++i) {
+        const EmergencyCase& c = *pq_.get(handles[i]);
+        countIn(c.priority);
+        track(handles[i]);
+        scheduleAging(handles[i], c, c.arrivalTime);
+    }
+}
+
+template <typename Queue>
+int BasicEmergencyPQModule<Queue>::logCase(const EmergencyCase& e) {
+    return logCase(EmergencyCase(e));
+}
 
-void EmergencyPQModule::logCase(const EmergencyCase& e) {
+template <typename Queue>
+int BasicEmergencyPQModule<Queue>::logCase(EmergencyCase&& e) {
     if (e.priority < 1 || e.priority > 5) {
         std::cout << "[Error] Invalid priority (" << e.priority
             << "). Must be 15.\n";
-        return;
+        return -1;
+    }
+    applyAging();
+
+    if (e.arrivalTime == 0) e.arrivalTime = clock_();
+    const int handle = pq_.push(std::move(e));
+    const EmergencyCase& c = *pq_.get(handle);
+    const int ticket = track(handle);
+    countIn(c.priority);
+    scheduleAging(handle, c, c.arrivalTime);
+    std::cout << "[OK] Logged emergency #" << ticket << ": " << c.name
+        << " (" << c.type << "), priority=" << c.priority << "\n";
+    return ticket;
+}
+
+template <typename Queue>
+int BasicEmergencyPQModule<Queue>::logCases(const EmergencyCase* cases, int count) {
+    applyAging();
+
+    const long long now = clock_();
+    DynamicArray<EmergencyCase> batch;
+    batch.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        if (cases[i].priority < 1 || cases[i].priority > 5) continue;
+        EmergencyCase& c = batch.emplace(cases[i]);
+        if (c.arrivalTime == 0) c.arrivalTime = now;
     }
-    g_pq.push(e);
-    std::cout << "[OK] Logged emergency: " << e.name
-        << " (" << e.type << "), priority=" << e.priority << "\n";
+    insertBatch(batch);
+
+    const int accepted = batch.size();
+    std::cout << "[OK] Logged " << accepted << " emergencies";
+    if (accepted < count) std::cout << " (" << (count - accepted) << " with invalid priority skipped)";
+    std::cout << "\n";
+    return accepted;
 }
 
-bool EmergencyPQModule::processTop(EmergencyCase& out) {
-    if (!g_pq.popMax(out)) {
+template <typename Queue>
+bool BasicEmergencyPQModule<Queue>::submit(const EmergencyCase& e) {
+    return submit(EmergencyCase(e));
+}
+
+template <typename Queue>
+bool BasicEmergencyPQModule<Queue>::submit(EmergencyCase&& e) {
+    if (e.priority < 1 || e.priority > 5) return false;
+    if (e.arrivalTime == 0) e.arrivalTime = clock_();
+    intake_.push(std::move(e));
+    return true;
+}
+
+template <typename Queue>
+int BasicEmergencyPQModule<Queue>::collectSubmitted() {
+    if (intake_.isEmpty()) return 0;
+
+    DynamicArray<EmergencyCase> batch;
+    EmergencyCase c;
+    while (intake_.tryPopMax(c)) batch.push(std::move(c));
+    insertBatch(batch);
+    return batch.size();
+}
+
+template <typename Queue>
+bool BasicEmergencyPQModule<Queue>::processTop(EmergencyCase& out) {
+    collectSubmitted();
+    applyAging();
+    const int handle = pq_.topHandle();
+    if (handle < 0 || !pq_.erase(handle, out)) {
         std::cout << "[Info] No pending emergency cases.\n";
         return false;
     }
+    const int triage = pending_[handle].triage;
+    untrack(handle);
+    countOut(out.priority);
+    recordWait(out, triage);
     std::cout << "[Processing] " << out.name
         << "  " << out.type
         << " (priority " << out.priority << ")\n";
     return true;
 }
 
-void EmergencyPQModule::printByPriority(std::ostream& os) const {
-    if (g_pq.isEmpty()) {
+template <typename Queue>
+void BasicEmergencyPQModule<Queue>::printByPriority(std::ostream& os) const {
+    if (pq_.isEmpty()) {
         os << "[Info] No emergency cases recorded.\n";
         return;
     }
 
-    PriorityQueue<EmergencyCase, EmergencyHigher> temp;
-    EmergencyCase c;
-
-    os << "\n+------------------------------------------------------+\n";
-    os << "|            PENDING EMERGENCY CASES (Top First)        |\n";
-    os << "+----------------------+----------------------+----------+\n";
-    os << "| Name                 | Type                 | Priority |\n";
-    os << "+----------------------+----------------------+----------+\n";
-
-    while (!g_pq.isEmpty()) {
-        const_cast<PriorityQueue<EmergencyCase, EmergencyHigher>&>(g_pq)
-            .popMax(c);
+    os << "\n+---------------------------------------------------------------+\n";
+    os << "|              PENDING EMERGENCY CASES (Top First)              |\n";
+    os << "+------+----------------------+----------------------+----------+\n";
+    os << "| #    | Name                 | Type                 | Priority |\n";
+    os << "+------+----------------------+----------------------+----------+\n";
 
-        os << "| " << std::left << std::setw(20) << c.name
+    pq_.forEachOrderedWithHandle([&](int handle, const EmergencyCase& c) {
+        os << "| " << std::left << std::setw(4) << pending_[handle].ticket
+            << " | " << std::left << std::setw(20) << c.name
             << " | " << std::left << std::setw(20) << c.type
             << " | " << std::right << std::setw(8) << c.priority << " |\n";
+        });
 
-        temp.push(c);
-    }
-
-    os << "+----------------------+----------------------+----------+\n";
-
-    
-    while (!temp.isEmpty()) {
-        temp.popMax(c);
-        const_cast<PriorityQueue<EmergencyCase, EmergencyHigher>&>(g_pq)
-            .push(c);
-    }
+    os << "+------+----------------------+----------------------+----------+\n";
 }
 
 
-bool EmergencyPQModule::peekTop(EmergencyCase& out) const {
-    if (!g_pq.peekMax(out)) {
+template <typename Queue>
+bool BasicEmergencyPQModule<Queue>::peekTop(EmergencyCase& out) const {
+    if (!pq_.peekMax(out)) {
         std::cout << "[Info] No pending emergency cases.\n";
         return false;
     }
@@ -86,44 +211,144 @@ bool EmergencyPQModule::peekTop(EmergencyCase& out) const {
 }
 
 
-void EmergencyPQModule::printStats(std::ostream& os) const {
-    if (g_pq.isEmpty()) {
+template <typename Queue>
+EmergencyStats BasicEmergencyPQModule<Queue>::stats() const {
+    return stats_;
+}
+
+
+template <typename Queue>
+int BasicEmergencyPQModule<Queue>::topK(int k, DynamicArray<EmergencyCase>& out) const {
+    out.clear();
+    if (k <= 0) return 0;
+    out.reserve(k < stats_.total ? k : stats_.total);
+    pq_.forEachOrdered([&](const EmergencyCase& c) { out.push(c); }, k);
+    return out.size();
+}
+
+
+template <typename Queue>
+int BasicEmergencyPQModule<Queue>::casesAtLeast(int p, DynamicArray<EmergencyCase>& out) const {
+    if (p < 1) p = 1;
+    int k = 0;
+    for (int level = p; level <= 5; ++level) k += stats_.counts[level];
+    return topK(k, out);
+}
+
+
+template <typename Queue>
+void BasicEmergencyPQModule<Queue>::printStats(std::ostream& os) const {
+    if (stats_.total == 0 && stats_.processed == 0) {
         os << "[Info] No emergency cases recorded.\n";
         return;
     }
 
-    PriorityQueue<EmergencyCase, EmergencyHigher> temp;
-    EmergencyCase c;
+    os << "\n[Emergency Statistics]\n";
+    os << "Total pending cases : " << stats_.total << "\n";
+    for (int p = 1; p <= 5; ++p) {
+        os << "Priority " << p << " cases : " << stats_.counts[p] << "\n";
+    }
+    os << "Highest current priority: " << stats_.maxPriority << "\n";
 
-    int total = 0;
-    int counts[6] = { 0, 0, 0, 0, 0, 0 }; 
-    int maxPriority = 1;
+    static const char* const waitLabels[6] = {
+        "< 1 min", "1-5 min", "5-15 min", "15-30 min", "30-60 min", ">= 60 min"
+    };
+    os << "\nProcessed cases : " << stats_.processed
+        << " (SLA breaches: " << stats_.slaBreaches << ")\n";
+    for (int b = 0; b < 6; ++b) {
+        os << "  Waited " << std::left << std::setw(10) << waitLabels[b]
+            << ": " << stats_.waitHistogram[b] << "\n";
+    }
+}
 
-    
-    while (!g_pq.isEmpty()) {
-        const_cast<PriorityQueue<EmergencyCase, EmergencyHigher>&>(g_pq)
-            .popMax(c);
 
-        ++total;
-        if (c.priority >= 1 && c.priority <= 5) {
-            ++counts[c.priority];
-            if (c.priority > maxPriority) maxPriority = c.priority;
-        }
 
-        temp.push(c);
+template <typename Queue>
+bool BasicEmergencyPQModule<Queue>::retriage(int ticket, int newPriority) {
+    if (newPriority < 1 || newPriority > 5) {
+        std::cout << "[Error] Invalid priority (" << newPriority
+            << "). Must be 15.\n";
+        return false;
+    }
+    const int handle = handleOf(ticket);
+    const EmergencyCase* current = handle >= 0 ? pq_.get(handle) : nullptr;
+    if (!current) {
+        std::cout << "[Error] No pending case #" << ticket << ".\n";
+        return false;
     }
 
-    
-    while (!temp.isEmpty()) {
-        temp.popMax(c);
-        const_cast<PriorityQueue<EmergencyCase, EmergencyHigher>&>(g_pq)
-            .push(c);
+    EmergencyCase c = *current;
+    countOut(c.priority);
+    c.priority = newPriority;
+    pq_.update(handle, c);
+    countIn(newPriority);
+    pending_[handle].triage = newPriority;   // a new clinical assessment
+    // Rescheduling retires any pending promotion, even for the same level;
+    // aging restarts from the new level.
+    scheduleAging(handle, c, clock_());
+    std::cout << "[Re-triaged] #" << ticket << " " << c.name
+        << " now priority " << newPriority << "\n";
+    return true;
+}
+
+template <typename Queue>
+bool BasicEmergencyPQModule<Queue>::cancel(int ticket, EmergencyCase& out) {
+    const int handle = handleOf(ticket);
+    if (handle < 0 || !pq_.erase(handle, out)) {
+        std::cout << "[Error] No pending case #" << ticket << ".\n";
+        return false;
     }
+    untrack(handle);
+    countOut(out.priority);
+    std::cout << "[Cancelled] #" << ticket << " " << out.name
+        << "  " << out.type << "\n";
+    return true;
+}
 
-    os << "\n[Emergency Statistics]\n";
-    os << "Total pending cases : " << total << "\n";
-    for (int p = 1; p <= 5; ++p) {
-        os << "Priority " << p << " cases : " << counts[p] << "\n";
+template <typename Queue>
+void BasicEmergencyPQModule<Queue>::setAgingPolicy(const AgingPolicy& policy) {
+    aging_ = policy;
+    // Reschedule every pending case under the new step (config changes only).
+    agingDue_.clear();
+    const long long now = clock_();
+    pq_.forEachOrderedWithHandle([&](int handle, const EmergencyCase& c) {
+        scheduleAging(handle, c, now);
+        });
+}
+
+template <typename Queue>
+void BasicEmergencyPQModule<Queue>::setClock(long long (*now)()) {
+    clock_.set(now);
+}
+
+template <typename Queue>
+int BasicEmergencyPQModule<Queue>::applyAging() {
+    if (aging_.stepSeconds <= 0) return 0;
+
+    const long long now = clock_();
+    int promoted = 0;
+    AgingEntry entry;
+    while (!agingDue_.isEmpty() && agingDue_.top().due <= now) {
+        agingDue_.popMax(entry);
+
+        // Skip entries for cases that were processed, cancelled or
+        // rescheduled since they were scheduled.
+        const int handle = handleOf(entry.ticket);
+        if (handle < 0 || pending_[handle].generation != entry.generation) continue;
+        const EmergencyCase* current = pq_.get(handle);
+
+        EmergencyCase c = *current;
+        countOut(c.priority);
+        ++c.priority;
+        pq_.update(handle, c);
+        countIn(c.priority);
+        // Next step counts from when this one was due, not from when we
+        // got round to applying it.
+        scheduleAging(handle, c, entry.due);
+        ++promoted;
     }
-    os << "Highest current priority: " << maxPriority << "\n";
+    return promoted;
 }
+
+template class BasicEmergencyPQModule<EmergencyHeap>;
+template class BasicEmergencyPQModule<EmergencyBuckets>;
@@ -1,10 +1,82 @@
 #pragma once
 #include <iosfwd>
+#include "core/Clock.hpp"
 #include "models/EmergencyCase.hpp"
+#include "ds/IndexedPriorityQueue.hpp"
+#include "ds/BucketQueue.hpp"
+#include "ds/ConcurrentPriorityQueue.hpp"
+#include "ds/DynamicArray.hpp"
+#include "ds/HashIndex.hpp"
 
-class EmergencyPQModule {
+// comparator - higher priority first, break ties alphabetically
+struct EmergencyHigher {
+    bool operator()(const EmergencyCase& a, const EmergencyCase& b) const {
+        if (a.priority != b.priority)
+            return a.priority > b.priority;
+        return a.name < b.name;
+    }
+};
+
+// bucket index for the 1..5 triage scale
+struct EmergencyLevel {
+    int operator()(const EmergencyCase& e) const { return e.priority - 1; }
+};
+
+// Backing stores the module can run on. Both hand out handles on push; the
+// module maps them to ticket numbers that are never reused, because a
+// handle is recycled as soon as its case leaves the queue.
+//  - EmergencyHeap: addressable binary heap, ties broken alphabetically
+//  - EmergencyBuckets: one FIFO per priority, O(1) push/pop, ties by arrival
+using EmergencyHeap = IndexedPriorityQueue<EmergencyCase, EmergencyHigher>;
+using EmergencyBuckets = BucketQueue<EmergencyCase, EmergencyLevel, 5>;
+
+// Pending-case counters kept up to date by logCase/processTop, so reading
+// them never touches the queue.
+struct EmergencyStats {
+    int total = 0;
+    int counts[6] = { 0, 0, 0, 0, 0, 0 }; // counts[p] for priority p in 1..5
+    int maxPriority = 0;                  // 0 when nothing is pending
+
+    // Waits of processed cases: <1m, 1-5m, 5-15m, 15-30m, 30-60m, 60m+
+    int processed = 0;
+    int waitHistogram[6] = { 0, 0, 0, 0, 0, 0 };
+    int slaBreaches = 0;                  // processed after their triage priority's SLA
+};
+
+// Starvation guard. A pending case gains one priority level (up to 5) for
+// every stepSeconds it waits; 0 turns aging off. Promotions are scheduled in
+// a min-heap of due times and applied lazily, so a clock tick only touches
+// the cases that are actually due - there is no periodic full re-heap.
+// Aging only reorders the queue: SLAs are judged by the triage priority.
+struct AgingPolicy {
+    int stepSeconds = 0;
+    int slaSeconds[6] = { 0, 7200, 3600, 1800, 600, 60 }; // max wait per priority 1..5
+};
+
+template <typename Queue>
+class BasicEmergencyPQModule {
 public:
-    void logCase(const EmergencyCase& e);          // Insert new case
+    BasicEmergencyPQModule();
+
+    int  logCase(const EmergencyCase& e);          // Insert new case, returns its ticket (-1 if rejected)
+    int  logCase(EmergencyCase&& e);
+
+    // Insert a whole batch (seed files, backlog restore) with one reservation
+    // and a bottom-up heap build. Cases with an invalid priority are skipped.
+    // Prints one summary line; returns how many cases were accepted.
+    int  logCases(const EmergencyCase* cases, int count);
+
+    // Thread-safe intake for triage desks: may be called from any thread
+    // while the dispatcher works the queue. Submitted cases wait in a
+    // concurrent queue until collectSubmitted() moves them into the main
+    // queue (processTop does this first). False if the priority is invalid.
+    bool submit(const EmergencyCase& e);
+    bool submit(EmergencyCase&& e);
+
+    // Dispatcher thread only. Moves every submitted case into the main
+    // queue in one batch; returns how many were moved.
+    int  collectSubmitted();
+
     bool processTop(EmergencyCase& out);           // Remove highest priority case
     void printByPriority(std::ostream& os) const;  // View all (non destructive)
 
@@ -13,4 +85,77 @@ public:
 
     // NEW: show statistics (total, count per priority, highest priority)
     void printStats(std::ostream& os) const;
+
+    // O(1) snapshot of the counters printed by printStats
+    EmergencyStats stats() const;
+
+    // The k most critical pending cases, best first, without modifying the
+    // queue: a frontier walk over the heap, O(k log k). Returns the count.
+    int  topK(int k, DynamicArray<EmergencyCase>& out) const;
+
+    // Every pending case with priority >= p, best first. The per-priority
+    // counters give the exact size up front, so this is topK of that size.
+    int  casesAtLeast(int p, DynamicArray<EmergencyCase>& out) const;
+
+    // Change the priority of a pending case (condition changed). O(log n).
+    // Tickets of cases that were processed or cancelled are rejected.
+    bool retriage(int ticket, int newPriority);
+
+    // Withdraw a pending case, e.g. transferred elsewhere. O(log n).
+    bool cancel(int ticket, EmergencyCase& out);
+
+    void setAgingPolicy(const AgingPolicy& policy);
+
+    // Time source in seconds (default: steady clock). Must be safe to call
+    // from submitting threads.
+    void setClock(long long (*now)());
+
+    // Apply every aging promotion that is due. Runs automatically before
+    // inserts and processTop; call it before a read-only view to show
+    // up-to-date priorities. Returns the number of promotions.
+    int  applyAging();
+
+private:
+    // Next promotion of one case; stale once the case left or was
+    // rescheduled (its generation moved on).
+    struct AgingEntry {
+        long long due;
+        int       ticket;
+        unsigned  generation;
+    };
+    struct EarlierDue {
+        bool operator()(const AgingEntry& a, const AgingEntry& b) const { return a.due < b.due; }
+    };
+    // Per-handle bookkeeping for a pending case.
+    struct Pending {
+        int      ticket;
+        int      triage;       // priority set at triage, before any aging
+        unsigned generation;   // bumped whenever aging is rescheduled
+    };
+
+    Queue          pq_;
+    HashIndex<int, int> handleOfTicket_;   // pending cases only
+    DynamicArray<Pending> pending_;        // indexed by handle
+    int            nextTicket_;
+    EmergencyStats stats_;
+    ConcurrentPriorityQueue<EmergencyCase, EmergencyHigher> intake_;
+    AgingPolicy    aging_;
+    PriorityQueue<AgingEntry, EarlierDue> agingDue_;
+    Clock          clock_;
+
+    int  track(int handle);          // new ticket for a freshly pushed case
+    void untrack(int handle);        // case left the queue
+    int  handleOf(int ticket) const; // -1 unless the ticket is pending
+
+    void countIn(int priority);
+    void countOut(int priority);
+    void recordWait(const EmergencyCase& c, int triage);
+    void scheduleAging(int handle, const EmergencyCase& c, long long from);
+    void insertBatch(DynamicArray<EmergencyCase>& batch);
 };
+
+// Both variants are instantiated in EmergencyPQModule.cpp.
+extern template class BasicEmergencyPQModule<EmergencyHeap>;
+extern template class BasicEmergencyPQModule<EmergencyBuckets>;
+
+using EmergencyPQModule = BasicEmergencyPQModule<EmergencyHeap>;
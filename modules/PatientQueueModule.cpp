@@ -1,31 +1,400 @@
 #include "PatientQueueModule.hpp"
-#include "../ds/LinkedQueue.hpp"
+#include "../ds/FenwickTree.hpp"
+#include "../ds/HashIndex.hpp"
+#include "../ds/IntrusiveQueue.hpp"
+#include "../ds/LockFreeQueue.hpp"
+#include "../ds/PoolAllocator.hpp"
+#include <cctype>
+#include <cstdint>
+#include <iomanip>
 #include <iostream>
+#include <new>
+#include <string>
 
-// Single queue instance for all patient operations in this translation unit
-static LinkedQueue<Patient> g_patients;
+namespace {
 
-void PatientQueueModule::admit(const Patient& p) {
-    g_patients.enqueue(p);
+    struct PatientNode : IntrusiveHook<PatientNode> {
+        PatientRecord patient;
+        int       lane;
+        int       ticket;       // admission order within the lane
+        long long admittedAt;
+    };
+
+    // One FIFO per lane. Tickets feed a Fenwick tree that counts who is
+    // still waiting ahead of a given patient in the same lane.
+    struct Lane {
+        std::string                 name;
+        int                         weight;
+        IntrusiveQueue<PatientNode> queue;
+        FenwickTree                 live;
+        int                         nextTicket = 0;
+        int                         served = 0;
+        long long                   totalWait = 0;
+        long long                   maxWait = 0;
+
+        Lane(const std::string& n, int w) : name(n), weight(w), live(64) {}
+    };
+
+    std::string lowerCopy(const std::string& s) {
+        std::string out(s);
+        for (char& ch : out) ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+        return out;
+    }
+
+    // The waiting lines: patients are routed to a lane by condition, an
+    // id -> node index gives O(1) lookup and removal from any lane, and
+    // discharge serves the lanes by deficit round robin - a lane gets
+    // `weight` patients per turn while it has anyone waiting.
+    class PatientLines {
+    public:
+        PatientLines() : waiting_(0), cursor_(0), credit_(0) {
+            addLane("General", 1);
+            credit_ = lanes_[0]->weight;   // General's turn comes first
+        }
+
+        ~PatientLines() {
+            for (int i = 0; i < lanes_.size(); ++i) {
+                while (PatientNode* n = lanes_[i]->queue.popFront()) destroy(n);
+                delete lanes_[i];
+            }
+        }
+
+        int addLane(const std::string& name, int weight) {
+            const int* existing = laneByName_.find(lowerCopy(name));
+            if (existing) {
+                lanes_[*existing]->weight = weight;
+                return *existing;
+            }
+            lanes_.push(new Lane(name, weight));
+            laneByName_.insert(lowerCopy(name), lanes_.size() - 1);
+            return lanes_.size() - 1;
+        }
+
+        int laneIndex(const std::string& name) const {
+            const int* lane = laneByName_.find(lowerCopy(name));
+            return lane ? *lane : -1;
+        }
+
+        void route(const std::string& condition, int lane) {
+            laneByCondition_.assign(lowerCopy(condition), lane);
+            laneByCode_.clear();
+        }
+
+        // Unrouted conditions go to General (lane 0). The answer for each
+        // condition code is cached until the routing changes.
+        int laneFor(std::uint16_t condition) {
+            while (laneByCode_.size() <= condition) laneByCode_.push(-1);
+            int& lane = laneByCode_[condition];
+            if (lane < 0) {
+                const int* routed = laneByCondition_.find(lowerCopy(ConditionTable::name(condition)));
+                lane = routed ? *routed : 0;
+            }
+            return lane;
+        }
+
+        bool contains(std::uint32_t id) const { return byId_.contains(id); }
+
+        int push(const PatientRecord& p, long long now) {
+            const int laneIdx = laneFor(p.condition);
+            Lane& lane = *lanes_[laneIdx];
+            if (lane.nextTicket == lane.live.size()) renumber(lane);
+
+            PatientNode* n = PoolNodeAllocator::allocate<PatientNode>();
+            try {
+                new (n) PatientNode();
+                n->patient = p;
+            }
+            catch (...) {
+                PoolNodeAllocator::deallocate<PatientNode>(n);
+                throw;
+            }
+            n->lane = laneIdx;
+            n->ticket = lane.nextTicket++;
+            n->admittedAt = now;
+            lane.live.add(n->ticket, 1);
+            lane.queue.pushBack(n);
+            byId_.insert(p.id, n);
+            ++waiting_;
+            return laneIdx;
+        }
+
+        // Deficit round robin over the lanes. Each turn visits a lane at
+        // most once, so this is O(lanes) worst case and O(1) typically.
+        bool popScheduled(PatientRecord& out, long long now) {
+            if (waiting_ == 0) return false;
+            while (true) {
+                Lane& lane = *lanes_[cursor_];
+                if (lane.queue.isEmpty()) credit_ = 0;   // idle lanes bank nothing
+                if (credit_ > 0) {
+                    --credit_;
+                    serve(lane.queue.front(), out, now);
+                    return true;
+                }
+                cursor_ = (cursor_ + 1) % lanes_.size();
+                credit_ = lanes_[cursor_]->weight;
+            }
+        }
+
+        bool popFrom(int laneIdx, PatientRecord& out, long long now) {
+            if (laneIdx < 0 || laneIdx >= lanes_.size()) return false;
+            PatientNode* n = lanes_[laneIdx]->queue.front();
+            if (!n) return false;
+            serve(n, out, now);
+            return true;
+        }
+
+        bool remove(std::uint32_t id, PatientRecord& out) {
+            PatientNode* const* n = byId_.find(id);
+            if (!n) return false;
+            take(*n, out);
+            return true;
+        }
+
+        const PatientRecord* find(std::uint32_t id) const {
+            PatientNode* const* n = byId_.find(id);
+            return n ? &(*n)->patient : nullptr;
+        }
+
+        int positionOf(std::uint32_t id) const {
+            PatientNode* const* n = byId_.find(id);
+            return n ? lanes_[(*n)->lane]->live.prefix((*n)->ticket) : -1;
+        }
+
+        const std::string* laneNameOf(std::uint32_t id) const {
+            PatientNode* const* n = byId_.find(id);
+            return n ? &lanes_[(*n)->lane]->name : nullptr;
+        }
+
+        int size() const { return waiting_; }
+        int laneCount() const { return lanes_.size(); }
+        const Lane& lane(int i) const { return *lanes_[i]; }
+
+    private:
+        DynamicArray<Lane*>                  lanes_;
+        HashIndex<std::string, int>          laneByName_;       // lower-case
+        HashIndex<std::string, int>          laneByCondition_;  // lower-case
+        DynamicArray<int>                    laneByCode_;       // -1 = not looked up
+        HashIndex<std::uint32_t, PatientNode*> byId_;
+        int                                  waiting_;
+        int                                  cursor_;   // lane whose turn it is
+        int                                  credit_;   // patients it may still send
+
+        void serve(PatientNode* n, PatientRecord& out, long long now) {
+            Lane& lane = *lanes_[n->lane];
+            const long long waited = now > n->admittedAt ? now - n->admittedAt : 0;
+            ++lane.served;
+            lane.totalWait += waited;
+            if (waited > lane.maxWait) lane.maxWait = waited;
+            take(n, out);
+        }
+
+        void take(PatientNode* n, PatientRecord& out) {
+            Lane& lane = *lanes_[n->lane];
+            out = std::move(n->patient);
+            lane.queue.remove(n);
+            lane.live.add(n->ticket, -1);
+            byId_.erase(out.id);
+            --waiting_;
+            destroy(n);
+        }
+
+        static void destroy(PatientNode* n) {
+            n->~PatientNode();
+            PoolNodeAllocator::deallocate<PatientNode>(n);
+        }
+
+        // Tickets only grow; once they reach the tree's size, hand out fresh
+        // ones 0..n-1 in queue order. The new size is at least twice the
+        // lane, so this runs at most once per n admissions.
+        static void renumber(Lane& lane) {
+            const int n = lane.queue.size();
+            lane.live.reset(2 * n > 64 ? 2 * n : 64);
+            int ticket = 0;
+            for (PatientNode* p = lane.queue.front(); p; p = p->next) {
+                p->ticket = ticket;
+                lane.live.add(ticket++, 1);
+            }
+            lane.nextTicket = ticket;
+        }
+    };
+
+} // namespace
+
+// Admission from a kiosk, stamped when it was submitted.
+struct Submission {
+    Patient   patient;
+    long long submittedAt;
+};
+
+// Single set of lines for all patient operations in this translation unit
+static PatientLines g_patients;
+
+// Kiosk admissions waiting to be moved into the lines by the desk thread.
+// Nodes are allocated on kiosk threads and freed on the desk thread; the
+// pool hands the desk's surplus back through its shared list.
+static LockFreeQueue<Submission, PoolNodeAllocator> g_intake;
+
+static bool admitAt(const Patient& p, long long now) {
+    PatientRecord r;
+    if (!parsePatientId(p.id, r.id)) {
+        std::cout << "[Error] Invalid patient ID " << p.id << " (expected P followed by digits).\n";
+        return false;
+    }
+    if (!ConditionTable::intern(p.conditionType, r.condition)) {
+        std::cout << "[Error] Too many distinct conditions.\n";
+        return false;
+    }
+    r.name = p.name;
+    if (g_patients.contains(r.id)) {
+        std::cout << "[Error] Patient " << formatPatientId(r.id) << " is already in the queue.\n";
+        return false;
+    }
+    g_patients.push(r, now);
+    return true;
+}
+
+bool PatientQueueModule::admit(const Patient& p) {
+    return admitAt(p, clock_());
+}
+
+bool PatientQueueModule::admit(const PatientRecord& r) {
+    if (r.condition >= ConditionTable::size()) {
+        std::cout << "[Error] Unknown condition code " << r.condition << " for patient "
+            << formatPatientId(r.id) << ".\n";
+        return false;
+    }
+    if (g_patients.contains(r.id)) {
+        std::cout << "[Error] Patient " << formatPatientId(r.id) << " is already in the queue.\n";
+        return false;
+    }
+    g_patients.push(r, clock_());
+    return true;
+}
+
+bool PatientQueueModule::submit(const Patient& p) {
+    std::uint32_t id;
+    if (!parsePatientId(p.id, id)) return false;
+    g_intake.enqueue(Submission{ p, clock_() });
+    return true;
+}
+
+int PatientQueueModule::collectSubmitted() {
+    int admitted = 0;
+    Submission s;
+    while (g_intake.dequeue(s)) {
+        if (admitAt(s.patient, s.submittedAt)) ++admitted;
+    }
+    return admitted;
 }
 
 bool PatientQueueModule::discharge(Patient& out) {
-    return g_patients.dequeue(out);
+    collectSubmitted();
+    PatientRecord r;
+    if (!g_patients.popScheduled(r, clock_())) return false;
+    out = toPatient(r);
+    return true;
 }
 
-void PatientQueueModule::printQueue(std::ostream& os) const {
-    
-    LinkedQueue<Patient> temp;
-    LinkedQueue<Patient> restore;
-    Patient item;
+bool PatientQueueModule::dischargeFrom(const std::string& lane, Patient& out) {
+    collectSubmitted();
+    PatientRecord r;
+    if (!g_patients.popFrom(g_patients.laneIndex(lane), r, clock_())) return false;
+    out = toPatient(r);
+    return true;
+}
+
+int PatientQueueModule::addLane(const std::string& name, int weight) {
+    return g_patients.addLane(name, weight < 1 ? 1 : weight);
+}
+
+bool PatientQueueModule::routeCondition(const std::string& condition, const std::string& lane) {
+    const int idx = g_patients.laneIndex(lane);
+    if (idx < 0) return false;
+    g_patients.route(condition, idx);
+    return true;
+}
 
-    while (g_patients.dequeue(item)) {
-        os << item.id << " | " << item.name
-            << " | " << item.conditionType << "\n";
-        restore.enqueue(item);
+std::string PatientQueueModule::laneOf(const std::string& id) const {
+    std::uint32_t key;
+    const std::string* name = parsePatientId(id, key) ? g_patients.laneNameOf(key) : nullptr;
+    return name ? *name : std::string();
+}
+
+int PatientQueueModule::laneStats(DynamicArray<LaneStats>& out) const {
+    out.clear();
+    for (int i = 0; i < g_patients.laneCount(); ++i) {
+        const Lane& lane = g_patients.lane(i);
+        LaneStats& s = out.emplace();
+        s.name = lane.name;
+        s.weight = lane.weight;
+        s.depth = lane.queue.size();
+        s.served = lane.served;
+        s.avgWaitSeconds = lane.served > 0
+            ? static_cast<double>(lane.totalWait) / lane.served : 0.0;
+        s.maxWaitSeconds = lane.maxWait;
+        if (!lane.queue.isEmpty()) {
+            const long long oldest = clock_() - lane.queue.front()->admittedAt;
+            s.oldestWaitSeconds = oldest > 0 ? oldest : 0;
+        }
+    }
+    return out.size();
+}
+
+void PatientQueueModule::printLaneStats(std::ostream& os) const {
+    DynamicArray<LaneStats> stats;
+    laneStats(stats);
+    os << "--- Triage Lanes ---\n"
+        << std::left << std::setw(14) << "Lane" << std::right
+        << std::setw(7) << "Weight" << std::setw(8) << "Depth" << std::setw(8) << "Served"
+        << std::setw(11) << "Avg wait" << std::setw(11) << "Max wait" << std::setw(11) << "Oldest" << "\n";
+    for (int i = 0; i < stats.size(); ++i) {
+        const LaneStats& s = stats[i];
+        os << std::left << std::setw(14) << s.name << std::right
+            << std::setw(7) << s.weight << std::setw(8) << s.depth << std::setw(8) << s.served
+            << std::setw(10) << std::fixed << std::setprecision(0) << s.avgWaitSeconds << "s"
+            << std::setw(10) << s.maxWaitSeconds << "s"
+            << std::setw(10) << s.oldestWaitSeconds << "s\n";
     }
+    os.unsetf(std::ios::floatfield);
+}
+
+void PatientQueueModule::setClock(long long (*now)()) {
+    clock_.set(now);
+}
+
+bool PatientQueueModule::findById(const std::string& id, Patient& out) const {
+    std::uint32_t key;
+    const PatientRecord* r = parsePatientId(id, key) ? g_patients.find(key) : nullptr;
+    if (!r) return false;
+    out = toPatient(*r);
+    return true;
+}
+
+bool PatientQueueModule::removeById(const std::string& id, Patient& out) {
+    std::uint32_t key;
+    PatientRecord r;
+    if (!parsePatientId(id, key) || !g_patients.remove(key, r)) return false;
+    out = toPatient(r);
+    return true;
+}
+
+int PatientQueueModule::positionOf(const std::string& id) const {
+    std::uint32_t key;
+    return parsePatientId(id, key) ? g_patients.positionOf(key) : -1;
+}
+
+int PatientQueueModule::size() const {
+    return g_patients.size();
+}
 
-    while (restore.dequeue(item)) {
-        g_patients.enqueue(item);
+void PatientQueueModule::printQueue(std::ostream& os) const {
+    for (int i = 0; i < g_patients.laneCount(); ++i) {
+        const Lane& lane = g_patients.lane(i);
+        if (lane.queue.isEmpty()) continue;
+        os << "[" << lane.name << "]\n";
+        lane.queue.forEach([&os](const PatientNode& n) {
+            os << formatPatientId(n.patient.id) << " | " << n.patient.name
+                << " | " << ConditionTable::name(n.patient.condition) << "\n";
+            });
     }
 }
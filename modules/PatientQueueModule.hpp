@@ -1,11 +1,83 @@
 #pragma once
 
 #include <iosfwd>
+#include <string>
+#include "../core/Clock.hpp"
 #include "../models/Patient.hpp"
+#include "../ds/DynamicArray.hpp"
 
+// Per-lane counters; wait times in seconds of the module clock.
+struct LaneStats {
+    std::string name;
+    int         weight = 1;
+    int         depth = 0;               // waiting now
+    int         served = 0;              // discharged through this lane
+    double      avgWaitSeconds = 0.0;    // of the served patients
+    long long   maxWaitSeconds = 0;
+    long long   oldestWaitSeconds = 0;   // head of the lane, 0 if empty
+};
+
+// Patients wait in per-condition lanes (e.g. Orthopedics, Fever, Cardiac);
+// conditions nobody routed go to the "General" lane.
 class PatientQueueModule {
 public:
-    void admit(const Patient& p);
+    // Joins the back of its condition's lane. Returns false if the ID is
+    // not of the form P### or a patient with the same ID is already waiting.
+    bool admit(const Patient& p);
+    // Already parsed and interned; also false if r.condition is not a code
+    // the ConditionTable has handed out.
+    bool admit(const PatientRecord& r);
+
+    // Thread-safe intake for registration kiosks: may be called from any
+    // number of threads while the desk works the lanes. Submissions wait in
+    // a lock-free queue until collectSubmitted() admits them (discharge and
+    // dischargeFrom do this first); duplicates are reported then. False if
+    // the ID is malformed. Every other method is for the desk thread only.
+    bool submit(const Patient& p);
+
+    // Desk thread only. Admits every pending submission, keeping its
+    // submission time as the start of the wait; returns how many got in.
+    int  collectSubmitted();
+
+    // Next patient across all lanes, by deficit round robin: each lane in
+    // turn sends up to `weight` patients, lanes with nobody waiting are
+    // skipped. O(1) per patient for a fixed set of lanes.
     bool discharge(Patient& out);
+
+    // Next patient of one lane, for a clinic working its own line. O(1).
+    bool dischargeFrom(const std::string& lane, Patient& out);
+
     void printQueue(std::ostream& os) const;
+
+    // Create a lane (or change its weight); returns its index.
+    int  addLane(const std::string& name, int weight);
+
+    // Send patients with this condition (case-insensitive) to the lane.
+    // False if the lane does not exist.
+    bool routeCondition(const std::string& condition, const std::string& lane);
+
+    // Lane a waiting patient is in, empty if not waiting.
+    std::string laneOf(const std::string& id) const;
+
+    int  laneStats(DynamicArray<LaneStats>& out) const;
+    void printLaneStats(std::ostream& os) const;
+
+    // Time source in seconds (default: steady clock).
+    void setClock(long long (*now)());
+
+    // O(1) lookup by patient ID.
+    bool findById(const std::string& id, Patient& out) const;
+
+    // Take a patient out of their lane wherever they are (transfer,
+    // walk-out). O(1).
+    bool removeById(const std::string& id, Patient& out);
+
+    // Patients ahead of this one in the same lane (0 = next), -1 if not
+    // waiting. O(log n).
+    int  positionOf(const std::string& id) const;
+
+    int  size() const;
+
+private:
+    Clock clock_;
 };
@@ -1,10 +1,13 @@
 #include "SupplyStackModule.hpp"
 
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <string>
+#include "../ds/DynamicArray.hpp"
+#include "../ds/IndexedPriorityQueue.hpp"
 #include "../ds/LinkedStack.hpp"
 
 namespace {
@@ -35,6 +38,162 @@ namespace {
 
 } // namespace
 
+// A stack entry names a shelf slot plus the serial of the batch it held;
+// once that batch has been issued FEFO the entry is stale and skipped.
+struct SupplyStackModule::StackRef {
+    int      slot;
+    unsigned serial;
+};
+
+// Every batch on the shelf lives in one slot. Besides the LIFO stack it is
+// reachable from a min-heap of its type keyed on expiry (handle kept in the
+// slot, so a LIFO issue can take it out of the heap in O(log n)) and from
+// the bucket of its expiry day (position kept in the slot, O(1) removal).
+// The days that have a bucket are also kept sorted, for range queries; a
+// new or emptied day shifts that list, which stays short next to the
+// number of batches.
+struct SupplyStackModule::Shelf {
+    struct Entry {
+        int      expiryDay;
+        unsigned serial;     // arrival order breaks ties
+        int      slot;
+    };
+
+    struct Sooner {
+        bool operator()(const Entry& a, const Entry& b) const {
+            if (a.expiryDay != b.expiryDay) return a.expiryDay < b.expiryDay;
+            return a.serial < b.serial;
+        }
+    };
+
+    typedef IndexedPriorityQueue<Entry, Sooner> ExpiryHeap;
+
+    struct Slot {
+        SupplyItem item;
+        unsigned   serial = 0;   // 0 = empty slot
+        int        type = -1;    // index into heaps
+        int        handle = -1;  // in heaps[type]
+        int        bucketPos = -1;
+    };
+
+    DynamicArray<Slot>                 slots;
+    DynamicArray<int>                  freeSlots;
+    unsigned                           nextSerial = 1;
+    HashIndex<std::string, int>        typeIds;
+    DynamicArray<ExpiryHeap*>          heaps;
+    HashIndex<int, DynamicArray<int>*> buckets;      // expiry day -> slots
+    DynamicArray<int>                  days;         // keys of buckets, ascending
+    int                                staleOnStack = 0;
+
+    Shelf() = default;
+    Shelf(const Shelf&) = delete;
+    Shelf& operator=(const Shelf&) = delete;
+
+    ~Shelf() {
+        for (int i = 0; i < heaps.size(); ++i) delete heaps[i];
+        buckets.forEach([](int, DynamicArray<int>* b) { delete b; });
+    }
+
+    int liveCount() const { return slots.size() - freeSlots.size(); }
+
+    bool holds(const StackRef& ref) const {
+        return slots[ref.slot].serial == ref.serial;
+    }
+
+    StackRef store(const SupplyItem& s) {
+        int slot;
+        if (freeSlots.size() > 0) {
+            slot = freeSlots[freeSlots.size() - 1];
+            freeSlots.pop();
+        }
+        else {
+            slot = slots.size();
+            slots.emplace();
+        }
+        Slot& entry = slots[slot];
+        entry.item = s;
+        entry.serial = nextSerial++;
+        if (nextSerial == 0) nextSerial = 1;
+
+        const int* known = typeIds.find(s.type);
+        if (known) {
+            entry.type = *known;
+        }
+        else {
+            entry.type = heaps.size();
+            heaps.push(new ExpiryHeap());
+            typeIds.insert(s.type, entry.type);
+        }
+        entry.handle = heaps[entry.type]->push(Entry{ s.expiryDay, entry.serial, slot });
+
+        entry.bucketPos = -1;
+        if (s.expiryDay != SUPPLY_NO_EXPIRY) {
+            DynamicArray<int>** bucket = buckets.find(s.expiryDay);
+            if (!bucket) {
+                buckets.insert(s.expiryDay, new DynamicArray<int>());
+                bucket = buckets.find(s.expiryDay);
+                addDay(s.expiryDay);
+            }
+            entry.bucketPos = (*bucket)->size();
+            (*bucket)->push(slot);
+        }
+        return StackRef{ slot, entry.serial };
+    }
+
+    // Empty the slot into out. inHeap is false when the caller already
+    // popped the slot's heap entry.
+    void release(int slot, bool inHeap, SupplyItem& out) {
+        Slot& entry = slots[slot];
+        if (inHeap) {
+            Entry dropped;
+            heaps[entry.type]->erase(entry.handle, dropped);
+        }
+        if (entry.bucketPos >= 0) {
+            DynamicArray<int>** found = buckets.find(entry.item.expiryDay);
+            DynamicArray<int>& bucket = **found;
+            const int last = bucket[bucket.size() - 1];
+            bucket[entry.bucketPos] = last;
+            slots[last].bucketPos = entry.bucketPos;
+            bucket.pop();
+            if (bucket.size() == 0) {
+                delete *found;
+                buckets.erase(entry.item.expiryDay);
+                removeDay(entry.item.expiryDay);
+            }
+        }
+        out = std::move(entry.item);
+        entry.item = SupplyItem();
+        entry.serial = 0;
+        entry.handle = entry.bucketPos = -1;
+        freeSlots.push(slot);
+    }
+
+    // Index of day in days, or where it would be inserted.
+    int dayPosition(int day) const {
+        const int* first = days.data();
+        return static_cast<int>(std::lower_bound(first, first + days.size(), day) - first);
+    }
+
+    void addDay(int day) {
+        const int pos = dayPosition(day);
+        days.push(day);
+        for (int i = days.size() - 1; i > pos; --i) days[i] = days[i - 1];
+        days[pos] = day;
+    }
+
+    void removeDay(int day) {
+        const int pos = dayPosition(day);
+        for (int i = pos; i + 1 < days.size(); ++i) days[i] = days[i + 1];
+        days.pop();
+    }
+};
+
+void SupplyStackModule::countOut(const SupplyItem& item) {
+    SupplyTotal* total = totals_.find(item.type);
+    if (total && --total->batches == 0) totals_.erase(item.type);
+    else if (total) total->quantity -= item.quantity;
+}
+
 void SupplyStackModule::add(const SupplyItem& s) {
     if (s.quantity <= 0) {
         std::cout << "[Error] Quantity must be greater than zero." << std::endl;
@@ -44,32 +203,155 @@ void SupplyStackModule::add(const SupplyItem& s) {
         std::cout << "[Error] Batch cannot be empty." << std::endl;
         return;
     }
-    stack_->push(s);
+    stack_->push(shelf_->store(s));
+    SupplyTotal* total = totals_.find(s.type);
+    if (!total) {
+        totals_.insert(s.type, SupplyTotal());
+        total = totals_.find(s.type);
+    }
+    total->quantity += s.quantity;
+    ++total->batches;
     std::cout << "[Info] Stock added: " << s.type << " x" << s.quantity
         << " (" << s.batch << ")" << std::endl;
 }
 
 bool SupplyStackModule::useLast(SupplyItem& out) {
-    if (!stack_->pop(out)) {
-        std::cout << "[Error] No supplies available." << std::endl;
-        return false;
+    StackRef ref;
+    while (stack_->pop(ref)) {
+        if (!shelf_->holds(ref)) {   // already issued FEFO
+            --shelf_->staleOnStack;
+            continue;
+        }
+        shelf_->release(ref.slot, true, out);
+        countOut(out);
+        return true;
+    }
+    std::cout << "[Error] No supplies available." << std::endl;
+    return false;
+}
+
+// The batch's stack entry is now stale. Once stale entries outnumber live
+// ones, rebuild the stack without them (amortized O(1) per removal).
+void SupplyStackModule::dropFromStack() {
+    if (++shelf_->staleOnStack > 32 && shelf_->staleOnStack > shelf_->liveCount()) {
+        DynamicArray<StackRef> live;
+        StackRef ref;
+        while (stack_->pop(ref)) {
+            if (shelf_->holds(ref)) live.push(ref);
+        }
+        for (int i = live.size() - 1; i >= 0; --i) stack_->push(live[i]);
+        shelf_->staleOnStack = 0;
+    }
+}
+
+bool SupplyStackModule::useFirstExpiring(const std::string& type, int today, SupplyItem& out) {
+    const int* typeId = shelf_->typeIds.find(type);
+    Shelf::ExpiryHeap* heap = typeId ? shelf_->heaps[*typeId] : nullptr;
+    Shelf::Entry next;
+    while (heap && heap->popMax(next)) {
+        shelf_->release(next.slot, false, out);
+        countOut(out);
+        dropFromStack();
+        if (out.expiryDay >= today) return true;
+
+        std::cout << "[Info] Quarantined expired " << out.type << " x" << out.quantity
+            << " (" << out.batch << ", expired " << formatDate(out.expiryDay) << ")" << std::endl;
+    }
+    std::cout << "[Error] No usable " << type << " in stock." << std::endl;
+    return false;
+}
+
+int SupplyStackModule::expiringWithin(int today, int days, DynamicArray<SupplyItem>& out) const {
+    out.clear();
+    const long long last = static_cast<long long>(today) + days;
+    for (int d = 0; d < shelf_->days.size() && shelf_->days[d] <= last; ++d) {
+        const DynamicArray<int>* bucket = *shelf_->buckets.find(shelf_->days[d]);
+        for (int i = 0; i < bucket->size(); ++i)
+            out.push(shelf_->slots[(*bucket)[i]].item);
+    }
+    return out.size();
+}
+
+void SupplyStackModule::printExpiring(std::ostream& os, int today, int days) const {
+    DynamicArray<SupplyItem> items;
+    expiringWithin(today, days, items);
+    if (items.size() == 0) {
+        os << "[Info] Nothing expired or expiring within " << days << " day(s)." << std::endl;
+        return;
     }
-    return true;
+    os << "[Info] Expired or expiring within " << days << " day(s):" << std::endl;
+    for (int i = 0; i < items.size(); ++i) {
+        os << "  " << formatDate(items[i].expiryDay) << "  " << items[i].type
+            << " x" << items[i].quantity << " (" << items[i].batch << ")";
+        if (items[i].expiryDay < today) os << "  EXPIRED";
+        os << "\n";
+    }
+}
+
+long long SupplyStackModule::stockOf(const std::string& type) const {
+    const SupplyTotal* total = totals_.find(type);
+    return total ? total->quantity : 0;
+}
+
+SupplyTotal SupplyStackModule::totalsOf(const std::string& type) const {
+    const SupplyTotal* total = totals_.find(type);
+    return total ? *total : SupplyTotal();
+}
+
+void SupplyStackModule::printSummary(std::ostream& os) const {
+    struct Row {
+        const std::string* type;
+        SupplyTotal        total;
+    };
+    DynamicArray<Row> rows;
+    rows.reserve(totals_.size());
+    std::size_t typeWidth = std::string("Type").size();
+    totals_.forEach([&](const std::string& type, const SupplyTotal& total) {
+        rows.push(Row{ &type, total });
+        if (type.size() > typeWidth) typeWidth = type.size();
+        });
+    if (rows.size() > 1) {
+        std::sort(&rows[0], &rows[0] + rows.size(), [](const Row& a, const Row& b) {
+            return *a.type < *b.type;
+            });
+    }
+
+    const auto defaultFlags = os.flags();
+    const std::size_t totalWidth = typeWidth + 27U;
+    divider(os, totalWidth);
+    os << "| " << std::left << std::setw(static_cast<int>(typeWidth)) << "Type"
+        << " | " << std::right << std::setw(10) << "Units"
+        << " | " << std::setw(7) << "Batches" << " |" << '\n';
+    divider(os, totalWidth);
+    if (rows.size() == 0) {
+        os << "| " << std::left << std::setw(static_cast<int>(totalWidth - 4U))
+            << "No supplies recorded" << " |" << '\n';
+    }
+    for (int i = 0; i < rows.size(); ++i) {
+        os << "| " << std::left << std::setw(static_cast<int>(typeWidth)) << *rows[i].type
+            << " | " << std::right << std::setw(10) << rows[i].total.quantity
+            << " | " << std::setw(7) << rows[i].total.batches << " |" << '\n';
+    }
+    os.flags(defaultFlags);
+    divider(os, totalWidth);
 }
 
 void SupplyStackModule::printAll(std::ostream& os) const {
     std::size_t typeWidth = std::string("Type").size();
     std::size_t qtyWidth = std::string("Qty").size();
     std::size_t batchWidth = std::string("Batch").size();
+    const std::size_t expiryWidth = std::string("YYYY-MM-DD").size();
 
-    stack_->forEach([&](const SupplyItem& item) {
+    stack_->forEach([&](const StackRef& ref) {
+        if (!shelf_->holds(ref)) return;
+        const SupplyItem& item = shelf_->slots[ref.slot].item;
         if (item.type.size() > typeWidth) typeWidth = item.type.size();
         std::size_t qDigits = digits(item.quantity);
         if (qDigits > qtyWidth) qtyWidth = qDigits;
         if (item.batch.size() > batchWidth) batchWidth = item.batch.size();
         });
 
-    const std::size_t totalWidth = typeWidth + qtyWidth + batchWidth + 10U;
+    const std::size_t totalWidth = typeWidth + qtyWidth + batchWidth + expiryWidth + 13U;
     const std::size_t innerMessageWidth = totalWidth - 4U;
 
     const auto defaultFlags = os.flags();
@@ -80,6 +362,7 @@ void SupplyStackModule::printAll(std::ostream& os) const {
     os << "| " << std::left << std::setw(static_cast<int>(typeWidth)) << "Type"
         << " | " << std::right << std::setw(static_cast<int>(qtyWidth)) << "Qty"
         << " | " << std::left << std::setw(static_cast<int>(batchWidth)) << "Batch"
+        << " | " << std::setw(static_cast<int>(expiryWidth)) << "Expiry"
         << " |" << '\n';
 
     os.flags(defaultFlags);
@@ -87,7 +370,7 @@ void SupplyStackModule::printAll(std::ostream& os) const {
 
     divider(os, totalWidth);
 
-    if (stack_->isEmpty()) {
+    if (shelf_->liveCount() == 0) {
         os << "| " << std::left << std::setw(static_cast<int>(innerMessageWidth))
             << "No supplies recorded" << " |" << '\n';
         os.flags(defaultFlags);
@@ -96,10 +379,13 @@ void SupplyStackModule::printAll(std::ostream& os) const {
         return;
     }
 
-    stack_->forEach([&](const SupplyItem& item) {
+    stack_->forEach([&](const StackRef& ref) {
+        if (!shelf_->holds(ref)) return;
+        const SupplyItem& item = shelf_->slots[ref.slot].item;
         os << "| " << std::left << std::setw(static_cast<int>(typeWidth)) << item.type
             << " | " << std::right << std::setw(static_cast<int>(qtyWidth)) << item.quantity
             << " | " << std::left << std::setw(static_cast<int>(batchWidth)) << item.batch
+            << " | " << std::setw(static_cast<int>(expiryWidth)) << formatDate(item.expiryDay)
             << " |" << '\n';
         os.flags(defaultFlags);
         os.fill(defaultFill);
@@ -109,11 +395,13 @@ void SupplyStackModule::printAll(std::ostream& os) const {
 }
 
 SupplyStackModule::SupplyStackModule() {
-    stack_ = new LinkedStack<SupplyItem>();
+    stack_ = new LinkedStack<StackRef, PoolNodeAllocator>();
+    shelf_ = new Shelf();
 }
 
 SupplyStackModule::~SupplyStackModule() {
     delete stack_;
+    delete shelf_;
 }
 
 
@@ -123,6 +411,10 @@ void runSupplySubmenu(SupplyStackModule& module) {
             << "1. Add stock\n"
             << "2. Use last added\n"
             << "3. View all supplies\n"
+            << "4. Stock of a type\n"
+            << "5. Stock summary by type\n"
+            << "6. Use first-expiring of a type (FEFO)\n"
+            << "7. Expired or expiring within N days\n"
             << "0. Back\n> ";
 
         int choice = -1;
@@ -157,6 +449,14 @@ void runSupplySubmenu(SupplyStackModule& module) {
             std::cout << "Batch: ";
             std::getline(std::cin, item.batch);
 
+            std::string expiry;
+            std::cout << "Expiry (YYYY-MM-DD, blank if none): ";
+            std::getline(std::cin, expiry);
+            if (!expiry.empty() && !parseDate(expiry, item.expiryDay)) {
+                std::cout << "[Error] Invalid expiry date." << std::endl;
+                break;
+            }
+
             module.add(item);
         } break;
 
@@ -173,8 +473,46 @@ void runSupplySubmenu(SupplyStackModule& module) {
             module.printAll(std::cout);
             break;
 
+        case 4: {
+            std::string type;
+            std::cout << "Type: ";
+            std::getline(std::cin, type);
+            const SupplyTotal total = module.totalsOf(type);
+            std::cout << "[Info] " << type << ": " << total.quantity << " units in "
+                << total.batches << " batch(es)" << std::endl;
+        } break;
+
+        case 5:
+            module.printSummary(std::cout);
+            break;
+
+        case 6: {
+            std::string type;
+            std::cout << "Type: ";
+            std::getline(std::cin, type);
+            SupplyItem used;
+            if (module.useFirstExpiring(type, todayDay(), used)) {
+                std::cout << "[Info] Used: " << used.type << " x" << used.quantity
+                    << " (" << used.batch << ", expires " << formatDate(used.expiryDay) << ")"
+                    << std::endl;
+            }
+        } break;
+
+        case 7: {
+            int days = 0;
+            std::cout << "Days: ";
+            if (!(std::cin >> days) || days < 0) {
+                std::cin.clear();
+                std::cout << "[Error] Invalid number of days." << std::endl;
+            }
+            else {
+                module.printExpiring(std::cout, todayDay(), days);
+            }
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        } break;
+
         default:
-            std::cout << "[Error] Choose a valid option (0-3)." << std::endl;
+            std::cout << "[Error] Choose a valid option (0-7)." << std::endl;
             break;
         }
     }
@@ -1,12 +1,24 @@
 #pragma once
 
 #include <iosfwd>
+#include <string>
 
+#include "../ds/DynamicArray.hpp"
+#include "../ds/HashIndex.hpp"
 #include "../models/SupplyItem.hpp"
 
-template <typename T>
+template <typename T, typename Alloc>
 class LinkedStack;
+struct PoolNodeAllocator;
 
+// Running stock of one supply type across all batches on the shelf.
+struct SupplyTotal {
+    long long quantity = 0;
+    int       batches = 0;
+};
+
+// Supplies on the shelf, issued either last-in-first-out (useLast) or,
+// for perishables, first-expired-first-out per type (useFirstExpiring).
 class SupplyStackModule {
 public:
     SupplyStackModule();
@@ -21,8 +33,40 @@ public:
     bool useLast(SupplyItem& out);
     void printAll(std::ostream& os) const;
 
+    // The batch of this type that expires soonest; batches without an
+    // expiry date go last, ties in order of arrival. Batches that expired
+    // before today are never issued: they are taken off the shelf and
+    // reported as quarantined on the way. O(log n) per batch removed.
+    bool useFirstExpiring(const std::string& type, int today, SupplyItem& out);
+
+    // Batches expiring on or before today + days, soonest first - including
+    // those already expired (expiryDay < today), which printExpiring flags.
+    // Walks the sorted list of days that have batches: O(d + k) for the d
+    // such days and k batches reported, however wide the window.
+    int  expiringWithin(int today, int days, DynamicArray<SupplyItem>& out) const;
+    void printExpiring(std::ostream& os, int today, int days) const;
+
+    // Units of this type on the shelf (exact type name), 0 if none. O(1).
+    long long   stockOf(const std::string& type) const;
+    SupplyTotal totalsOf(const std::string& type) const;
+
+    // One line per type in name order, from the running totals: O(k log k)
+    // for k types, independent of how many batches are stacked.
+    void printSummary(std::ostream& os) const;
+
 private:
-    LinkedStack<SupplyItem>* stack_;
+    struct StackRef;   // a batch on the LIFO stack
+    struct Shelf;      // batch storage, per-type expiry heaps, day buckets
+
+    // Batches come and go all day; pooled nodes skip the heap on each one.
+    LinkedStack<StackRef, PoolNodeAllocator>* stack_;
+    Shelf*                                    shelf_;
+
+    // type -> totals, kept in step with the shelf by add and the use* calls.
+    HashIndex<std::string, SupplyTotal> totals_;
+
+    void countOut(const SupplyItem& item);
+    void dropFromStack();   // a batch left through its heap, not the stack
 };
 
 void runSupplySubmenu(SupplyStackModule& module);
@@ -0,0 +1,190 @@
+// IndexedPriorityQueue against a plain array model: random push, update,
+// erase and popMax, checking handles and heap order after every step.
+// Then EmergencyPQModule tickets: a ticket that has left the queue must not
+// reach the case that reuses its handle.
+//   g++ -std=c++17 -I. "test/test_ PriorityQueue.cpp" modules/EmergencyPQModule.cpp -o test_PriorityQueue
+
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include "ds/DynamicArray.hpp"
+#include "ds/IndexedPriorityQueue.hpp"
+#include "modules/EmergencyPQModule.hpp"
+
+struct Item {
+    int key;
+    int id;   // unique, so ties are broken and order is total
+};
+
+struct Higher {
+    bool operator()(const Item& a, const Item& b) const {
+        if (a.key != b.key) return a.key > b.key;
+        return a.id < b.id;
+    }
+};
+
+// Model: one entry per live handle.
+struct Live {
+    int  handle;
+    Item item;
+};
+
+static int bestOf(const DynamicArray<Live>& live) {
+    int best = 0;
+    for (int i = 1; i < live.size(); ++i)
+        if (Higher()(live[i].item, live[best].item)) best = i;
+    return best;
+}
+
+static void removeLive(DynamicArray<Live>& live, int i) {
+    live[i] = live[live.size() - 1];
+    live.pop();
+}
+
+static void checkAgainst(const IndexedPriorityQueue<Item, Higher>& q, const DynamicArray<Live>& live) {
+    assert(q.size() == live.size());
+    for (int i = 0; i < live.size(); ++i) {
+        const Item* v = q.get(live[i].handle);
+        assert(v && v->id == live[i].item.id && v->key == live[i].item.key);
+        (void)v;
+    }
+    if (live.size() > 0) assert(q.topHandle() == live[bestOf(live)].handle);
+
+    // Ordered walk is non-increasing and sees everything once.
+    int visited = 0;
+    bool first = true;
+    Item prev{ 0, 0 };
+    q.forEachOrdered([&](const Item& v) {
+        if (!first) assert(!Higher()(v, prev));
+        prev = v;
+        first = false;
+        ++visited;
+        });
+    assert(visited == live.size());
+}
+
+static void randomizedIndexedHeap() {
+    std::mt19937 rng(4);
+    IndexedPriorityQueue<Item, Higher> q;
+    DynamicArray<Live> live;
+    int nextId = 0;
+
+    for (int step = 0; step < 20000; ++step) {
+        const int op = static_cast<int>(rng() % 10);
+        const bool grow = live.size() < 300;   // keep the model small
+        if ((op < 4 && grow) || live.size() == 0) {
+            const Item v{ static_cast<int>(rng() % 50), nextId++ };
+            const int h = q.push(v);
+            for (int i = 0; i < live.size(); ++i) assert(live[i].handle != h);
+            live.push(Live{ h, v });
+        }
+        else if (op < 6) {
+            const int i = static_cast<int>(rng() % live.size());
+            const Item v{ static_cast<int>(rng() % 50), live[i].item.id };
+            const bool updated = q.update(live[i].handle, v);
+            assert(updated);
+            (void)updated;
+            live[i].item = v;
+        }
+        else if (op < 8) {
+            const int i = static_cast<int>(rng() % live.size());
+            Item out;
+            const bool erased = q.erase(live[i].handle, out);
+            assert(erased && out.id == live[i].item.id);
+            assert(!q.contains(live[i].handle));
+            Item again;
+            const bool twice = q.erase(live[i].handle, again);
+            assert(!twice);
+            (void)erased;
+            (void)twice;
+            removeLive(live, i);
+        }
+        else if (op < 9) {
+            const int best = bestOf(live);
+            Item out;
+            const bool popped = q.popMax(out);
+            assert(popped && out.id == live[best].item.id);
+            (void)popped;
+            removeLive(live, best);
+        }
+        else if (grow) {
+            // Bulk insert, reporting the handle of each element.
+            Item batch[5];
+            int handles[5];
+            const int k = 1 + static_cast<int>(rng() % 5);
+            for (int i = 0; i < k; ++i) batch[i] = Item{ static_cast<int>(rng() % 50), nextId++ };
+            q.pushRange(batch, batch + k, handles);
+            for (int i = 0; i < k; ++i) live.push(Live{ handles[i], batch[i] });
+        }
+        checkAgainst(q, live);
+    }
+
+    Item out;
+    while (live.size() > 0) {
+        const int best = bestOf(live);
+        const bool popped = q.popMax(out);
+        assert(popped && out.id == live[best].item.id);
+        (void)popped;
+        removeLive(live, best);
+    }
+    const bool drained = !q.popMax(out);
+    assert(drained && q.isEmpty() && q.topHandle() == -1);
+    (void)drained;
+}
+
+// Regression: handles are recycled, so a ticket that was the handle of a
+// processed case used to cancel (or re-triage) whoever got the handle next.
+template <typename Module>
+static void staleTicketsAreRejected() {
+    Module m;
+    EmergencyCase out;
+    bool ok;
+
+    const int alice = m.logCase(EmergencyCase{ "Alice", "Burn", 3 });
+    ok = m.processTop(out);
+    assert(ok && out.name == "Alice");
+    const int bob = m.logCase(EmergencyCase{ "Bob", "Fracture", 2 });
+    assert(bob != alice);
+    ok = !m.cancel(alice, out) && !m.retriage(alice, 5);
+    assert(ok);
+    assert(m.stats().total == 1);
+
+    const int carol = m.logCase(EmergencyCase{ "Carol", "Cut", 1 });
+    ok = m.cancel(bob, out);
+    assert(ok && out.name == "Bob");
+    ok = !m.cancel(bob, out);
+    assert(ok);
+    const int dave = m.logCase(EmergencyCase{ "Dave", "Sprain", 1 });
+    assert(dave != bob && dave != carol);
+    ok = !m.retriage(bob, 4);
+    assert(ok);
+
+    // Batch-loaded cases get fresh tickets too.
+    EmergencyCase batch[2] = { { "Erin", "Flu", 4 }, { "Finn", "Flu", 4 } };
+    ok = m.logCases(batch, 2) == 2 && m.retriage(dave, 5);
+    assert(ok);
+    ok = m.cancel(carol, out);
+    assert(ok && out.name == "Carol");
+    ok = m.processTop(out);
+    assert(ok && out.name == "Dave");
+    ok = !m.cancel(dave, out);
+    assert(ok);
+    assert(m.stats().total == 2);
+    (void)ok;
+    (void)alice;
+}
+
+int main() {
+    randomizedIndexedHeap();
+    std::printf("IndexedPriorityQueue: ok\n");
+
+    std::cout.setstate(std::ios::failbit);   // the module narrates each step
+    staleTicketsAreRejected<BasicEmergencyPQModule<EmergencyHeap>>();
+    staleTicketsAreRejected<BasicEmergencyPQModule<EmergencyBuckets>>();
+    std::cout.clear();
+    std::printf("EmergencyPQModule tickets: ok\n");
+
+    std::printf("test_PriorityQueue: ok\n");
+    return 0;
+}
@@ -0,0 +1,217 @@
+// CircularQueue rotate/removeAt against an array model. The growable ring
+// reports every element it moves, so a value -> slot index kept from those
+// reports must agree with the ring after every step. Then the same through
+// AmbulanceCircularModule, whose positionOf() reads such an index.
+//   g++ -std=c++17 -I. test/test_CircularQueue.cpp modules/AmbulanceCircularModule.cpp modules/DispatchEngine.cpp -o test_CircularQueue
+
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include "ds/CircularQueue.hpp"
+#include "ds/DynamicArray.hpp"
+#include "modules/AmbulanceCircularModule.hpp"
+
+struct Unit {
+    int         id;
+    std::string code;   // non-trivial payload, so moves are exercised
+};
+
+static std::string codeOf(int id) {
+    return "AMB-" + std::to_string(id);
+}
+
+// Model order, front first.
+static void removeModelAt(DynamicArray<int>& order, int i) {
+    for (int j = i; j + 1 < order.size(); ++j) order[j] = order[j + 1];
+    order.pop();
+}
+
+static void rotateModel(DynamicArray<int>& order, int k) {
+    const int n = order.size();
+    if (n <= 1) return;
+    k %= n;
+    if (k < 0) k += n;
+    DynamicArray<int> next;
+    for (int i = 0; i < n; ++i) next.push(order[(i + k) % n]);
+    for (int i = 0; i < n; ++i) order[i] = next[i];
+}
+
+using Ring = CircularQueue<Unit, CIRCULAR_GROWABLE>;
+
+static void checkRing(const Ring& q, const DynamicArray<int>& order, const DynamicArray<int>& slotOfId) {
+    assert(q.getCount() == order.size());
+    for (int i = 0; i < order.size(); ++i) {
+        const Unit& u = q.at(i);
+        assert(u.id == order[i] && u.code == codeOf(order[i]));
+        const int s = slotOfId[u.id];
+        assert(s == q.slotOf(i));
+        assert(q.positionOfSlot(s) == i);
+        assert(q.atSlot(s).id == u.id);
+        (void)s;
+    }
+}
+
+static void randomizedRing() {
+    std::mt19937 rng(11);
+    Ring q(4);
+    DynamicArray<int> order;
+    DynamicArray<int> slotOfId;   // -1 once the unit has left
+    int capacity = q.getCapacity();
+
+    auto moved = [&](const Unit& u, int newSlot) { slotOfId[u.id] = newSlot; };
+    auto reindex = [&] {
+        for (int i = 0; i < q.getCount(); ++i) slotOfId[q.at(i).id] = q.slotOf(i);
+        capacity = q.getCapacity();
+    };
+
+    for (int step = 0; step < 20000; ++step) {
+        const int op = static_cast<int>(rng() % 10);
+        const bool grow = order.size() < 200;   // keep the model small
+        if ((op < 4 && grow) || order.size() == 0) {
+            const int id = slotOfId.size();
+            q.enqueue(Unit{ id, codeOf(id) });
+            order.push(id);
+            slotOfId.push(q.slotOf(q.getCount() - 1));
+            if (q.getCapacity() != capacity) reindex();   // growth moves everything
+        }
+        else if (op < 6) {
+            const int n = order.size();
+            const int k = static_cast<int>(rng() % (2 * n + 1)) - n;   // negative too
+            q.rotate(k, moved);
+            rotateModel(order, k);
+        }
+        else if (op < 8) {
+            const int i = static_cast<int>(rng() % order.size());
+            const Unit u = q.removeAt(i, moved);
+            assert(u.id == order[i]);
+            slotOfId[u.id] = -1;
+            removeModelAt(order, i);
+        }
+        else if (op < 9) {
+            const Unit u = q.dequeue();
+            assert(u.id == order[0]);
+            slotOfId[u.id] = -1;
+            removeModelAt(order, 0);
+        }
+        else {
+            // Fill the ring exactly: a full rotate only moves the front.
+            while (q.getCount() < q.getCapacity() && grow) {
+                const int id = slotOfId.size();
+                q.enqueue(Unit{ id, codeOf(id) });
+                order.push(id);
+                slotOfId.push(q.slotOf(q.getCount() - 1));
+            }
+            const int k = 1 + static_cast<int>(rng() % 7);
+            q.rotate(k, moved);
+            rotateModel(order, k);
+        }
+        checkRing(q, order, slotOfId);
+    }
+
+    bool threw = false;
+    try {
+        q.removeAt(q.getCount());
+    }
+    catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+    (void)threw;
+}
+
+static void fixedRotate() {
+    for (int count = 1; count <= 5; ++count) {
+        for (int k = -7; k <= 7; ++k) {
+            CircularQueue<int, 5> q;
+            DynamicArray<int> order;
+            // Start mid-buffer so rotation wraps the array end.
+            q.enqueue(-1);
+            q.enqueue(-2);
+            q.dequeue();
+            q.dequeue();
+            for (int i = 0; i < count; ++i) {
+                q.enqueue(i);
+                order.push(i);
+            }
+            q.rotate(k);
+            rotateModel(order, k);
+            assert(q.getCount() == count);
+            for (int i = 0; i < count; ++i) assert(q.at(i) == order[i]);
+            for (int i = 0; i < count; ++i) {
+                const int v = q.dequeue();
+                assert(v == order[i]);
+                (void)v;
+            }
+            assert(q.isEmpty());
+        }
+    }
+}
+
+static void modulePositions() {
+    std::mt19937 rng(12);
+    AmbulanceCircularModule m;
+    DynamicArray<int> order;
+    int nextId = 0;
+
+    for (int step = 0; step < 3000; ++step) {
+        const int op = static_cast<int>(rng() % 8);
+        if (op < 3 || order.size() == 0) {
+            Ambulance a;
+            a.code = codeOf(nextId);
+            a.driverName = "Driver";
+            const bool added = m.registerAmbulance(a);
+            assert(added);
+            (void)added;
+            order.push(nextId++);
+        }
+        else if (op < 5) {
+            const int k = static_cast<int>(rng() % (order.size() + 3));
+            const bool ok = m.advanceRotation(k);
+            assert(ok);
+            (void)ok;
+            rotateModel(order, k);
+        }
+        else if (op < 6) {
+            const int i = static_cast<int>(rng() % order.size());
+            const bool ok = m.rotateTo(codeOf(order[i]));
+            assert(ok);
+            (void)ok;
+            rotateModel(order, i);
+        }
+        else {
+            const int i = static_cast<int>(rng() % order.size());
+            Ambulance out;
+            const bool removed = m.removeAmbulance(codeOf(order[i]), out);
+            assert(removed && out.code == codeOf(order[i]));
+            (void)removed;
+            assert(m.positionOf(out.code) == -1);
+            removeModelAt(order, i);
+        }
+
+        assert(m.getAmbulanceCount() == order.size());
+        for (int i = 0; i < order.size(); ++i) {
+            assert(m.positionOf(codeOf(order[i])) == i);
+            assert(m.findByCode(codeOf(order[i])) != nullptr);
+        }
+        Ambulance front;
+        if (order.size() > 0) assert(m.nextAvailable(front) && front.code == codeOf(order[0]));
+    }
+}
+
+int main() {
+    randomizedRing();
+    std::printf("growable rotate/removeAt: ok\n");
+
+    fixedRotate();
+    std::printf("fixed rotate: ok\n");
+
+    std::cout.setstate(std::ios::failbit);   // the module narrates each step
+    modulePositions();
+    std::cout.clear();
+    std::printf("AmbulanceCircularModule positions: ok\n");
+
+    std::printf("test_CircularQueue: ok\n");
+    return 0;
+}
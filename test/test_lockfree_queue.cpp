@@ -0,0 +1,122 @@
+// LockFreeQueue stress: kiosk threads enqueue while desk threads dequeue.
+// Every admission must come out exactly once, each producer's admissions in
+// the order they went in, and with the pool allocator (nodes allocated on
+// one thread, freed on another) the slab count must stay bounded by what is
+// in flight. Meant to be run under -fsanitize=address and =thread as well.
+//   g++ -std=c++17 -pthread -I. test/test_lockfree_queue.cpp -o test_lockfree_queue
+
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include "ds/DynamicArray.hpp"
+#include "ds/LockFreeQueue.hpp"
+
+struct Admission {
+    int         kiosk;
+    int         seq;
+    std::string note;   // non-trivial payload, so moves and frees are exercised
+};
+
+// PoolNodeAllocator that records the most slabs its pool ever held.
+struct WatchedPool {
+    static std::atomic<int> maxSlabs;
+
+    template <typename Node>
+    static Node* allocate() {
+        Node* n = PoolNodeAllocator::allocate<Node>();
+        const int slabs = NodePool<sizeof(Node), alignof(Node)>::slabCount();
+        int seen = maxSlabs.load();
+        while (slabs > seen && !maxSlabs.compare_exchange_weak(seen, slabs)) {}
+        return n;
+    }
+
+    template <typename Node>
+    static void deallocate(Node* p) { PoolNodeAllocator::deallocate(p); }
+};
+std::atomic<int> WatchedPool::maxSlabs(0);
+
+static const int Kiosks = 3;
+static const int Desks = 3;
+static const int PerKiosk = 100000;
+static const int MaxInFlight = 4096;
+
+template <typename Alloc>
+static void stress() {
+    LockFreeQueue<Admission, Alloc> q;
+    std::atomic<int> enqueued(0), dequeued(0);
+    const int total = Kiosks * PerKiosk;
+
+    DynamicArray<std::atomic<unsigned char>*> seen;
+    for (int k = 0; k < Kiosks; ++k) {
+        seen.push(new std::atomic<unsigned char>[PerKiosk]);
+        for (int i = 0; i < PerKiosk; ++i) seen[k][i].store(0);
+    }
+
+    DynamicArray<std::thread> threads;
+    for (int k = 0; k < Kiosks; ++k) {
+        threads.emplace([&, k] {
+            for (int i = 0; i < PerKiosk; ++i) {
+                while (enqueued.load() - dequeued.load() >= MaxInFlight) std::this_thread::yield();
+                q.emplace(Admission{ k, i, "kiosk " + std::to_string(k) });
+                enqueued.fetch_add(1);
+            }
+            });
+    }
+    for (int d = 0; d < Desks; ++d) {
+        threads.emplace([&] {
+            int last[Kiosks];
+            for (int k = 0; k < Kiosks; ++k) last[k] = -1;
+            Admission a;
+            while (dequeued.load() < total) {
+                if (!q.dequeue(a)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                assert(a.kiosk >= 0 && a.kiosk < Kiosks);
+                assert(a.note == "kiosk " + std::to_string(a.kiosk));
+                assert(a.seq > last[a.kiosk]);   // per-producer FIFO
+                last[a.kiosk] = a.seq;
+                const unsigned char before = seen[a.kiosk][a.seq].fetch_add(1);
+                assert(before == 0);
+                (void)before;
+                dequeued.fetch_add(1);
+            }
+            });
+    }
+    for (int i = 0; i < threads.size(); ++i) threads[i].join();
+
+    Admission a;
+    assert(!q.dequeue(a));
+    assert(q.isEmpty());
+    for (int k = 0; k < Kiosks; ++k) {
+        for (int i = 0; i < PerKiosk; ++i) assert(seen[k][i].load() == 1);
+        delete[] seen[k];
+    }
+
+    // Leftovers are released by the destructor.
+    for (int i = 0; i < 1000; ++i) q.enqueue(Admission{ 0, i, "left" });
+}
+
+int main() {
+    stress<HeapNodeAllocator>();
+    std::printf("heap allocator: ok\n");
+
+    stress<WatchedPool>();
+    // Blocks in flight: MaxInFlight queued, up to ScanThreshold retired
+    // nodes per thread and up to two slabs on each thread's free list. A
+    // thread draining the shared list may sit on what it took while another
+    // carves, so allow four times that - still far below the one slab per
+    // 256 admissions (Kiosks * PerKiosk / 256) of unbounded growth.
+    const int threads = Kiosks + Desks + 1;
+    const int inFlight = (MaxInFlight + threads * (4 * 64 + 2 * 256)) / 256;
+    const int bound = 4 * inFlight;
+    std::printf("pool allocator: peak slabs %d (bound %d)\n", WatchedPool::maxSlabs.load(), bound);
+    std::fflush(stdout);
+    assert(WatchedPool::maxSlabs.load() <= bound);
+    std::printf("pool allocator: ok\n");
+
+    std::printf("test_lockfree_queue: ok\n");
+    return 0;
+}
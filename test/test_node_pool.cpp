@@ -0,0 +1,95 @@
+// NodePool under cross-thread frees: one thread allocates, another frees.
+// The freeing thread's surplus must flow back to the allocating thread, so
+// the number of slabs stays bounded by what is live, not by the total.
+//   g++ -std=c++17 -pthread -I. test/test_node_pool.cpp -o test_node_pool
+
+#include <cassert>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include "ds/DynamicArray.hpp"
+#include "ds/PoolAllocator.hpp"
+
+struct Ticket {
+    int  id;
+    int  lane;
+    long stamp;
+};
+
+using Pool = PoolNodeAllocator;
+
+// Batches travel from producer to consumer; at most MaxPending in flight.
+struct Handoff {
+    static const int MaxPending = 4;
+
+    std::mutex                      lock;
+    std::condition_variable         changed;
+    DynamicArray<DynamicArray<Ticket*>*> batches;
+    int                             head = 0;
+    bool                            done = false;
+};
+
+static void produce(Handoff& h, int total, int batchSize) {
+    for (int made = 0; made < total;) {
+        DynamicArray<Ticket*>* batch = new DynamicArray<Ticket*>();
+        for (int i = 0; i < batchSize && made < total; ++i, ++made) {
+            Ticket* t = Pool::allocate<Ticket>();
+            t->id = made;
+            batch->push(t);
+        }
+        std::unique_lock<std::mutex> guard(h.lock);
+        h.changed.wait(guard, [&] { return h.batches.size() - h.head < Handoff::MaxPending; });
+        h.batches.push(batch);
+        h.changed.notify_all();
+    }
+    std::lock_guard<std::mutex> guard(h.lock);
+    h.done = true;
+    h.changed.notify_all();
+}
+
+static long long consume(Handoff& h) {
+    long long seen = 0;
+    int expected = 0;
+    while (true) {
+        DynamicArray<Ticket*>* batch;
+        {
+            std::unique_lock<std::mutex> guard(h.lock);
+            h.changed.wait(guard, [&] { return h.head < h.batches.size() || h.done; });
+            if (h.head == h.batches.size()) return seen;
+            batch = h.batches[h.head++];
+            h.changed.notify_all();
+        }
+        for (int i = 0; i < batch->size(); ++i) {
+            assert((*batch)[i]->id == expected);
+            ++expected;
+            Pool::deallocate((*batch)[i]);
+            ++seen;
+        }
+        delete batch;
+    }
+}
+
+int main() {
+    const int total = 2000000;
+    const int batchSize = 1000;
+
+    Handoff h;
+    long long seen = 0;
+    std::thread consumer([&] { seen = consume(h); });
+    std::thread producer([&] { produce(h, total, batchSize); });
+    producer.join();
+    consumer.join();
+    assert(seen == total);
+
+    // Live blocks never exceed (MaxPending + 2) batches, plus up to two
+    // slabs' worth parked on each thread's list.
+    const int slabs = NodePool<sizeof(Ticket), alignof(Ticket)>::slabCount();
+    const int liveBlocks = (Handoff::MaxPending + 2) * batchSize;
+    const int bound = liveBlocks / 256 + 8;
+    std::printf("slabs carved: %d (bound %d)\n", slabs, bound);
+    assert(slabs <= bound);
+
+    std::printf("test_node_pool: ok\n");
+    return 0;
+}
@@ -0,0 +1,131 @@
+// HashIndex against a plain array model: random insert, assign, erase and
+// find. A hash with only a few distinct values builds long probe runs that
+// wrap the table end, so the backward-shift erase has to keep every later
+// entry of a run reachable. Then duplicate codes through
+// AmbulanceCircularModule, which the index rejects.
+//   g++ -std=c++17 -I. test/test_queue.cpp modules/AmbulanceCircularModule.cpp modules/DispatchEngine.cpp -o test_queue
+
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include "ds/DynamicArray.hpp"
+#include "ds/HashIndex.hpp"
+#include "modules/AmbulanceCircularModule.hpp"
+
+// Four home slots for the whole table.
+struct Clustered {
+    std::size_t operator()(int key) const { return static_cast<std::size_t>(key & 3); }
+};
+
+struct ClusteredText {
+    std::size_t operator()(const std::string& key) const { return key.size() & 3; }
+};
+
+static std::string textOf(int key) {
+    return std::string(static_cast<std::size_t>(1 + key % 7), 'k') + std::to_string(key);
+}
+
+// present[k] / value[k] model the map for keys 0..Keys-1.
+template <typename Index, typename KeyOf>
+static void randomized(unsigned seed, int keys, int steps, KeyOf keyOf) {
+    std::mt19937 rng(seed);
+    Index index;
+    DynamicArray<int> present, value;
+    for (int k = 0; k < keys; ++k) {
+        present.push(0);
+        value.push(0);
+    }
+    int live = 0;
+
+    for (int step = 0; step < steps; ++step) {
+        const int k = static_cast<int>(rng() % keys);
+        const int op = static_cast<int>(rng() % 10);
+        if (op < 4) {
+            const int v = static_cast<int>(rng());
+            const bool inserted = index.insert(keyOf(k), v);
+            assert(inserted == !present[k]);
+            if (inserted) {
+                present[k] = 1;
+                value[k] = v;
+                ++live;
+            }
+        }
+        else if (op < 5) {
+            const int v = static_cast<int>(rng());
+            index.assign(keyOf(k), v);
+            if (!present[k]) ++live;
+            present[k] = 1;
+            value[k] = v;
+        }
+        else if (op < 9) {
+            const bool erased = index.erase(keyOf(k));
+            assert(erased == (present[k] != 0));
+            if (erased) {
+                present[k] = 0;
+                --live;
+            }
+        }
+        else if (op == 9 && rng() % 64 == 0) {
+            index.clear();
+            for (int j = 0; j < keys; ++j) present[j] = 0;
+            live = 0;
+        }
+
+        // Every key still findable after the shifts, nothing resurrected.
+        assert(index.size() == live);
+        for (int j = 0; j < keys; ++j) {
+            const int* v = index.find(keyOf(j));
+            assert((v != nullptr) == (present[j] != 0));
+            if (v) assert(*v == value[j]);
+        }
+    }
+
+    int visited = 0;
+    index.forEach([&](const auto&, int) { ++visited; });
+    assert(visited == live);
+}
+
+static void duplicateCodes() {
+    AmbulanceCircularModule m;
+    Ambulance a;
+    a.code = "AMB01";
+    a.driverName = "First";
+    const bool first = m.registerAmbulance(a);
+    a.driverName = "Second";
+    const bool second = m.registerAmbulance(a);
+    assert(first && !second);
+    assert(m.getAmbulanceCount() == 1);
+    assert(m.findByCode("AMB01")->driverName == "First");
+
+    Ambulance out;
+    const bool removed = m.removeAmbulance("AMB01", out);
+    assert(removed && out.driverName == "First");
+    const bool again = m.removeAmbulance("AMB01", out);
+    assert(!again);
+    assert(m.findByCode("AMB01") == nullptr);
+    const bool reused = m.registerAmbulance(a);   // the code is free again
+    assert(reused);
+    (void)first; (void)second; (void)removed; (void)again; (void)reused;
+}
+
+int main() {
+    randomized<HashIndex<int, int, Clustered>>(13, 40, 20000, [](int k) { return k; });
+    std::printf("colliding int keys: ok\n");
+
+    randomized<HashIndex<std::string, int, ClusteredText>>(14, 40, 20000, textOf);
+    std::printf("colliding string keys: ok\n");
+
+    // Default hash, enough keys to rehash several times.
+    randomized<HashIndex<int, int>>(15, 500, 20000, [](int k) { return k * 7919; });
+    std::printf("default hash: ok\n");
+
+    std::cout.setstate(std::ios::failbit);   // the module narrates each step
+    duplicateCodes();
+    std::cout.clear();
+    std::printf("duplicate ambulance codes: ok\n");
+
+    std::printf("test_queue: ok\n");
+    return 0;
+}
@@ -0,0 +1,186 @@
+// SupplyStackModule issue order: useFirstExpiring never hands out an expired
+// batch and quarantines the ones it skips; expiringWithin lists soonest
+// first, expired batches included. Then random adds and issues against an
+// array model of the shelf, mixing LIFO and FEFO.
+//   g++ -std=c++17 -I. test/test_stack.cpp modules/SupplyStackModule.cpp -o test_stack
+
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include "ds/DynamicArray.hpp"
+#include "modules/SupplyStackModule.hpp"
+
+static int dayOf(const char* text) {
+    int day = 0;
+    const bool ok = parseDate(text, day);
+    assert(ok);
+    (void)ok;
+    return day;
+}
+
+static void quarantine() {
+    const int today = dayOf("2026-10-17");
+    SupplyStackModule m;
+    m.add(SupplyItem{ "Saline", 5, "S-old", today - 3 });
+    m.add(SupplyItem{ "Saline", 7, "S-today", today });
+    m.add(SupplyItem{ "Saline", 9, "S-later", today + 30 });
+    m.add(SupplyItem{ "Gauze", 2, "G-old", today - 1 });
+    SupplyItem out;
+    bool ok;
+
+    // Expiring today is still usable; three days ago is not.
+    ok = m.useFirstExpiring("Saline", today, out);
+    assert(ok && out.batch == "S-today");
+    assert(m.stockOf("Saline") == 9);
+    ok = m.useFirstExpiring("Saline", today, out);
+    assert(ok && out.batch == "S-later");
+    ok = !m.useFirstExpiring("Saline", today, out) && !m.useFirstExpiring("Gauze", today, out);
+    assert(ok);
+    assert(m.stockOf("Gauze") == 0 && m.totalsOf("Gauze").batches == 0);
+    ok = !m.useLast(out);   // quarantined batches left the stack too
+    assert(ok);
+
+    for (int i = 0; i < 200; ++i)
+        m.add(SupplyItem{ "Old", 1, "B" + std::to_string(i), today - 1 - i % 5 });
+    m.add(SupplyItem{ "Old", 1, "fresh", today + 1 });
+    ok = m.useFirstExpiring("Old", today, out);
+    assert(ok && out.batch == "fresh");
+    ok = !m.useLast(out);
+    assert(ok);
+    (void)ok;
+}
+
+static void expiringOrder() {
+    const int today = dayOf("2026-10-17");
+    SupplyStackModule m;
+    m.add(SupplyItem{ "A", 1, "late", today + 400 });
+    m.add(SupplyItem{ "A", 1, "exp", today - 10 });
+    m.add(SupplyItem{ "B", 1, "soon", today + 2 });
+    m.add(SupplyItem{ "B", 1, "soon2", today + 2 });
+    m.add(SupplyItem{ "C", 1, "none" });
+    m.add(SupplyItem{ "C", 1, "today", today });
+    DynamicArray<SupplyItem> out;
+
+    assert(m.expiringWithin(today, 5, out) == 4);
+    assert(out[0].batch == "exp" && out[1].batch == "today");
+    assert(out[2].expiryDay == today + 2 && out[3].expiryDay == today + 2);
+    assert(m.expiringWithin(today, 1000000000, out) == 5);   // no overflow
+    assert(out[4].batch == "late");
+    assert(m.expiringWithin(2000000000, 2000000000, out) == 5);
+
+    std::ostringstream os;
+    m.printExpiring(os, today, 5);
+    assert(os.str().find("exp)  EXPIRED") != std::string::npos);
+    assert(os.str().find("today)  EXPIRED") == std::string::npos);
+
+    SupplyItem it;
+    bool ok = m.useFirstExpiring("B", today, it) && m.useFirstExpiring("B", today, it);
+    assert(ok);
+    assert(m.expiringWithin(today, 5, out) == 2);
+    ok = m.useFirstExpiring("A", today, it);   // quarantines "exp" on the way
+    assert(ok && it.batch == "late");
+    assert(m.expiringWithin(today, 1000, out) == 1 && out[0].batch == "today");
+    while (m.useLast(it)) {}
+    assert(m.expiringWithin(today, 100000, out) == 0);
+    (void)ok;
+}
+
+// Model: batches on the shelf in arrival order.
+struct Batch {
+    SupplyItem item;
+    int        seq;
+};
+
+static void takeModel(DynamicArray<Batch>& shelf, int i) {
+    for (int j = i; j + 1 < shelf.size(); ++j) shelf[j] = shelf[j + 1];
+    shelf.pop();
+}
+
+static void randomizedShelf() {
+    static const char* const types[] = { "Saline", "Gauze", "Insulin" };
+    std::mt19937 rng(25);
+    const int start = dayOf("2026-10-17");
+    SupplyStackModule m;
+    DynamicArray<Batch> shelf;
+    int seq = 0;
+
+    for (int step = 0; step < 4000; ++step) {
+        const int today = start + step / 100;   // the clock moves on
+        const std::string type = types[rng() % 3];
+        const int op = static_cast<int>(rng() % 10);
+        SupplyItem out;
+
+        if (op < 5) {
+            SupplyItem s{ type, 1 + static_cast<int>(rng() % 20), "B" + std::to_string(seq),
+                          today - 5 + static_cast<int>(rng() % 40) };
+            if (rng() % 8 == 0) s.expiryDay = SUPPLY_NO_EXPIRY;
+            m.add(s);
+            shelf.push(Batch{ s, seq++ });
+        }
+        else if (op < 7) {
+            const bool used = m.useLast(out);
+            assert(used == (shelf.size() > 0));
+            if (used) {
+                assert(out.batch == shelf[shelf.size() - 1].item.batch);
+                shelf.pop();
+            }
+        }
+        else {
+            // Expired batches of this type go; then the soonest, oldest first.
+            int best = -1;
+            for (int i = 0; i < shelf.size();) {
+                const SupplyItem& s = shelf[i].item;
+                if (s.type == type && s.expiryDay < today) {
+                    takeModel(shelf, i);
+                    continue;
+                }
+                if (s.type == type && (best < 0 || s.expiryDay < shelf[best].item.expiryDay)) best = i;
+                ++i;
+            }
+            const bool used = m.useFirstExpiring(type, today, out);
+            assert(used == (best >= 0));
+            if (used) {
+                assert(out.batch == shelf[best].item.batch && out.expiryDay >= today);
+                takeModel(shelf, best);
+            }
+        }
+
+        long long stock = 0;
+        for (int i = 0; i < shelf.size(); ++i)
+            if (shelf[i].item.type == type) stock += shelf[i].item.quantity;
+        assert(m.stockOf(type) == stock);
+
+        if (step % 50 == 0) {
+            const int days = static_cast<int>(rng() % 30);
+            DynamicArray<SupplyItem> listed;
+            int expected = 0;
+            for (int i = 0; i < shelf.size(); ++i)
+                if (shelf[i].item.expiryDay <= today + days) ++expected;
+            assert(m.expiringWithin(today, days, listed) == expected && listed.size() == expected);
+            for (int i = 1; i < listed.size(); ++i) assert(listed[i - 1].expiryDay <= listed[i].expiryDay);
+        }
+    }
+}
+
+int main() {
+    std::cout.setstate(std::ios::failbit);   // the module narrates each step
+    quarantine();
+    std::cout.clear();
+    std::printf("FEFO quarantine: ok\n");
+
+    std::cout.setstate(std::ios::failbit);
+    expiringOrder();
+    std::cout.clear();
+    std::printf("expiringWithin order: ok\n");
+
+    std::cout.setstate(std::ios::failbit);
+    randomizedShelf();
+    std::cout.clear();
+    std::printf("random shelf: ok\n");
+
+    std::printf("test_stack: ok\n");
+    return 0;
+}